@@ -0,0 +1,642 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../lib/bitap.hpp"
+#include "../lib/bitarray.hpp"
+#include "../lib/bitarray_codec.hpp"
+#include "../lib/bitarray_pool.hpp"
+#include "../lib/bitarray_random.hpp"
+#include "../lib/bitarray_snapshot.hpp"
+#include "../lib/bitarray_stream.hpp"
+#include "../lib/bitmatrix.hpp"
+#include "../lib/bitsliced_index.hpp"
+#include "../lib/bloomfilter.hpp"
+#include "../lib/hamming_index.hpp"
+
+namespace
+{
+    // keeps the result of a benchmarked loop alive so that the compiler does not remove it
+    volatile long long sink = 0;
+
+    // returns a pseudo-random sequence of keys
+    std::vector<std::uint64_t> make_keys(int num, std::uint64_t seed)
+    {
+        std::vector<std::uint64_t> keys(num);
+
+        for (int i = 0; i < num; ++i)
+        {
+            seed += 0x9E3779B97F4A7C15ULL; // splitmix64 step
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            keys[i] = z ^ (z >> 31);
+        }
+
+        return keys;
+    }
+
+    // runs f once and prints the throughput of its ops operations on one core
+    template <typename F>
+    void run(const char *name, long long ops, F f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto stop = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(stop - start).count();
+
+        std::printf("%-40s %10.2f Mops/s per core %10.3f ms\n", name, ops / seconds / 1e6, seconds * 1e3);
+    }
+
+    // Bloom filter insert and lookup with single and batched calls
+    void bench_bloomfilter()
+    {
+        const int num_keys = 1 << 22;
+        std::vector<std::uint64_t> keys = make_keys(num_keys, 1);
+        std::vector<std::uint64_t> other = make_keys(num_keys, 2);
+        std::unique_ptr<bool[]> out(new bool[num_keys]);
+
+        BloomFilter filter(num_keys * 10);
+
+        run("bloomfilter insert", num_keys, [&] {
+            for (std::uint64_t key : keys)
+                filter.insert(key);
+        });
+
+        BloomFilter batched(num_keys * 10);
+
+        run("bloomfilter insert_many", num_keys, [&] { batched.insert_many(keys.data(), num_keys); });
+
+        run("bloomfilter contains (hits)", num_keys, [&] {
+            long long hits = 0;
+            for (std::uint64_t key : keys)
+                hits += filter.contains(key);
+            sink = hits;
+        });
+
+        run("bloomfilter contains (misses)", num_keys, [&] {
+            long long hits = 0;
+            for (std::uint64_t key : other)
+                hits += filter.contains(key);
+            sink = hits;
+        });
+
+        run("bloomfilter contains_many", num_keys, [&] { filter.contains_many(other.data(), num_keys, out.get()); });
+    }
+
+    // BitMatrix transpose and multiplications, the throughput is counted in bits of the result
+    void bench_bitmatrix()
+    {
+        const int n = 2048;
+        std::vector<std::uint64_t> keys = make_keys(n * n / 64, 3);
+
+        BitMatrix a(n, n);
+        BitMatrix b(n, n);
+
+        for (int r = 0; r < n; ++r)
+        {
+            for (int c = 0; c < n / 64; ++c)
+            {
+                a.row(r).data()[c] = static_cast<unsigned long>(keys[r * (n / 64) + c]);
+                b.row(r).data()[c] = static_cast<unsigned long>(keys[r * (n / 64) + c] >> 1);
+            }
+        }
+
+        run("bitmatrix transpose 2048x2048", static_cast<long long>(n) * n, [&] { sink = a.transpose().get(1, 2); });
+        run("bitmatrix multiply 2048x2048", static_cast<long long>(n) * n, [&] { sink = a.multiply(b).get(1, 2); });
+        run("bitmatrix boolean_multiply 2048x2048", static_cast<long long>(n) * n, [&] { sink = a.boolean_multiply(b).get(1, 2); });
+        run("bitmatrix rank 2048x2048", static_cast<long long>(n) * n, [&] { sink = a.rank(); });
+    }
+
+    // BitArray add, sub and multiply by a small constant on a wide integer, the throughput is counted in words
+    void bench_arithmetic()
+    {
+        const int num_bits = 1 << 20;
+        const int words = num_bits / 64;
+        const int repeats = 1000;
+        std::vector<std::uint64_t> keys = make_keys(2 * words, 4);
+
+        BitArray a = BitArray::from_words(keys.data(), num_bits);
+        BitArray b = BitArray::from_words(keys.data() + words, num_bits);
+
+        run("arithmetic add", static_cast<long long>(words) * repeats, [&] {
+            long long carries = 0;
+            for (int i = 0; i < repeats; ++i)
+                carries += a.add(b);
+            sink = carries;
+        });
+
+        run("arithmetic sub", static_cast<long long>(words) * repeats, [&] {
+            long long borrows = 0;
+            for (int i = 0; i < repeats; ++i)
+                borrows += a.sub(b);
+            sink = borrows;
+        });
+
+        run("arithmetic multiply", static_cast<long long>(words) * repeats, [&] {
+            unsigned long overflow = 0;
+            for (int i = 0; i < repeats; ++i)
+                overflow ^= a.multiply(12345);
+            sink = static_cast<long long>(overflow);
+        });
+    }
+
+    // streaming count and XOR of file bitmaps, the throughput is counted in words of one input file
+    void bench_stream()
+    {
+        const int words = 1 << 23; // 64 MiB per file
+        const char *tmp = std::getenv("TMPDIR");
+        const std::string dir = tmp != nullptr ? std::string(tmp) + "/" : std::string("/tmp/");
+        const std::string a = dir + "bitarray_bench_a.bin";
+        const std::string b = dir + "bitarray_bench_b.bin";
+        const std::string out = dir + "bitarray_bench_out.bin";
+
+        for (int k = 0; k < 2; ++k)
+        {
+            std::vector<std::uint64_t> keys = make_keys(words, 5 + k);
+            std::FILE *file = std::fopen((k == 0 ? a : b).c_str(), "wb");
+            std::fwrite(keys.data(), sizeof(std::uint64_t), keys.size(), file);
+            std::fclose(file);
+        }
+
+        run("stream count", words, [&] { sink = stream_count(a); });
+        run("stream xor", words, [&] { stream_xor(a, b, out); });
+
+        std::remove(a.c_str());
+        std::remove(b.c_str());
+        std::remove(out.c_str());
+    }
+
+    // Elias-Fano and stream-VByte encoding and decoding of a sparse array, the throughput is counted in bytes of the decoded bitmap (Mops/s = MB/s)
+    void bench_codec()
+    {
+        const int num_bits = 1 << 26;
+        const int words = num_bits / 64;
+        std::vector<std::uint64_t> keys = make_keys(4 * words, 6);
+        std::vector<std::uint64_t> sparse(words);
+
+        for (int i = 0; i < words; ++i)
+            sparse[i] = keys[4 * i] & keys[4 * i + 1] & keys[4 * i + 2] & keys[4 * i + 3]; // about 1 true bit in 16
+
+        BitArray arr = BitArray::from_words(sparse.data(), num_bits);
+        BitArray out(num_bits);
+        EliasFano e;
+        VByteList list;
+
+        run("codec elias_fano_encode", num_bits / 8, [&] { e = elias_fano_encode(arr); });
+        run("codec elias_fano_decode", num_bits / 8, [&] { elias_fano_decode(e, out); });
+        run("codec vbyte_encode", num_bits / 8, [&] { list = vbyte_encode(arr); });
+        run("codec vbyte_decode", num_bits / 8, [&] { vbyte_decode(list, out); });
+
+        std::printf("codec sizes: bitmap %d bytes, elias-fano %d bytes, vbyte %zu bytes\n", num_bits / 8,
+                    (e.low.size() + e.high.size()) / 8, list.control.size() + list.data.size());
+    }
+
+    // bit-sliced index range, equality, top-k and SUM over a column of 16-bit values, the throughput is counted in rows
+    void bench_bitsliced_index()
+    {
+        const int num_rows = 1 << 24;
+        std::vector<std::uint64_t> values = make_keys(num_rows, 7);
+
+        for (std::uint64_t &v : values)
+            v &= 0xFFFF;
+
+        BitSlicedIndex index;
+
+        run("bsi build", num_rows, [&] { index = BitSlicedIndex(values.data(), num_rows); });
+        run("bsi between", num_rows, [&] { sink = index.between(100, 5000).count(); });
+        run("bsi equal", num_rows, [&] { sink = index.equal(1234).count(); });
+        run("bsi top_k", num_rows, [&] { sink = index.top_k(1000).count(); });
+
+        BitArray rows = index.less(30000);
+
+        run("bsi sum", num_rows, [&] { sink = static_cast<long long>(index.sum(rows)); });
+    }
+
+    // extraction of the true bit indices of a dense and a sparse array against a scan with operator[], the throughput is counted in indices
+    void bench_indices()
+    {
+        const int num_bits = 1 << 26;
+        const int words = num_bits / 64;
+        std::vector<std::uint64_t> keys = make_keys(2 * words, 8);
+        std::vector<std::uint64_t> sparse(words);
+
+        for (int i = 0; i < words; ++i)
+            sparse[i] = keys[2 * i] & keys[2 * i + 1]; // about 1 true bit in 4
+
+        BitArray dense = BitArray::from_words(keys.data(), num_bits);
+        BitArray thin = BitArray::from_words(sparse.data(), num_bits);
+        std::vector<std::uint32_t> out(num_bits);
+        std::vector<std::uint32_t> list;
+
+        run("indices scan dense", dense.count(), [&] {
+            int k = 0;
+            for (int i = 0; i < num_bits; ++i)
+            {
+                if (dense[i])
+                    out[k++] = i;
+            }
+            sink = k;
+        });
+        run("indices to_indices dense", dense.count(), [&] { sink = dense.to_indices(out.data()); });
+        run("indices to_indices sparse", thin.count(), [&] { sink = thin.to_indices(out.data()); });
+        run("indices append_indices sparse", thin.count(), [&] { thin.append_indices(list); });
+    }
+
+    // random fill a bit at a time against fill_random and fill_bernoulli, the throughput is counted in bits
+    void bench_random()
+    {
+        const int num_bits = 1 << 26;
+        Xoshiro256 rng(10);
+        BitArray arr(num_bits);
+
+        run("random set per bit", num_bits, [&] {
+            for (int i = 0; i < num_bits; ++i)
+                arr.set(i, rng() & 1);
+        });
+        run("random fill_random", num_bits, [&] { arr.fill_random(rng); });
+        run("random fill_bernoulli 0.5", num_bits, [&] { arr.fill_bernoulli(0.5, rng); });
+        run("random fill_bernoulli 0.01", num_bits, [&] { arr.fill_bernoulli(0.01, rng); });
+        run("random random_set_bit", 1 << 10, [&] {
+            for (int i = 0; i < (1 << 10); ++i)
+                sink = arr.random_set_bit(rng);
+        });
+    }
+
+    // subset-sum dynamic programming with a |= a >> w through a temporary against or_shifted, the throughput is counted in words
+    void bench_shift()
+    {
+        const int num_bits = 1 << 20;
+        const int num_items = 256;
+        std::vector<std::uint64_t> weights = make_keys(num_items, 11);
+        BitArray a(num_bits), b(num_bits);
+        long long words = static_cast<long long>(num_items) * num_bits / 64;
+
+        a.set(0);
+        run("shift temporary a |= a >> w", words, [&] {
+            for (std::uint64_t w : weights)
+                a |= a >> static_cast<int>(w % 4096);
+        });
+
+        b.set(0);
+        run("shift or_shifted(a, -w)", words, [&] {
+            for (std::uint64_t w : weights)
+                b.or_shifted(b, -static_cast<int>(w % 4096));
+        });
+
+        sink = a == b;
+    }
+
+    // search of a 100-character pattern in a lower-case text with bitap against std::search and std::boyer_moore_searcher, the throughput is counted in text bytes (Mops/s = MB/s)
+    void bench_bitap()
+    {
+        const int num_bytes = 1 << 26;
+        std::vector<std::uint64_t> keys = make_keys(num_bytes / 8, 12);
+        std::string text(num_bytes, 'a');
+
+        for (int i = 0; i < num_bytes; ++i)
+            text[i] = static_cast<char>('a' + ((keys[i / 8] >> (8 * (i % 8))) & 0xFF) % 26);
+
+        const std::string pattern = text.substr(num_bytes / 2, 100);
+        std::vector<std::string> patterns = {pattern};
+
+        for (int p = 1; p < 8; ++p)
+            patterns.push_back(text.substr(num_bytes / 8 * p + 17, 100));
+
+        run("bitap std::search", num_bytes, [&] {
+            long long n = 0;
+            for (auto it = std::search(text.begin(), text.end(), pattern.begin(), pattern.end()); it != text.end(); it = std::search(it + 1, text.end(), pattern.begin(), pattern.end()))
+                ++n;
+            sink = n;
+        });
+        run("bitap std::boyer_moore_searcher", num_bytes, [&] {
+            std::boyer_moore_searcher<std::string::const_iterator> searcher(pattern.begin(), pattern.end());
+            long long n = 0;
+            for (auto it = std::search(text.cbegin(), text.cend(), searcher); it != text.cend(); it = std::search(it + 1, text.cend(), searcher))
+                ++n;
+            sink = n;
+        });
+
+        BitapMatcher exact({pattern});
+        BitapMatcher multi(patterns);
+        BitapMatcher mismatch({pattern}, 4, BitapMode::mismatch);
+        BitapMatcher edit({pattern}, 4, BitapMode::edit);
+
+        run("bitap exact", num_bytes, [&] { sink = exact.find_all(text).size(); });
+        run("bitap exact 8 patterns", num_bytes, [&] { sink = multi.find_all(text).size(); });
+        run("bitap 4 mismatches", num_bytes, [&] { sink = mismatch.find_all(text).size(); });
+        run("bitap 4 edits", num_bytes, [&] { sink = edit.find_all(text).size(); });
+    }
+
+    // count and AND with a mask over a million 512-bit members of a pool against a vector of separately allocated arrays, the throughput is counted in members
+    void bench_pool()
+    {
+        const int num_members = 1 << 20;
+        const int num_bits = 512;
+        std::vector<std::uint64_t> keys = make_keys(num_members, 13);
+        std::vector<BitArray> arrays;
+        BitArrayPool pool(num_bits);
+        BitArray mask(num_bits);
+
+        mask.set(0).set(100).set(511);
+        pool.reserve(num_members);
+
+        for (int k = 0; k < num_members; ++k)
+        {
+            BitArray arr(num_bits, keys[k]);
+            arrays.push_back(arr);
+            pool.push_back(arr);
+        }
+
+        std::vector<std::uint64_t> order = make_keys(num_members, 14);
+
+        for (int k = num_members - 1; k > 0; --k)
+            std::swap(arrays[k], arrays[order[k] % (k + 1)]); // the heap blocks of the vector are scattered like those of long-lived entities
+
+        run("pool vector<BitArray> count", num_members, [&] {
+            long long n = 0;
+            for (const BitArray &arr : arrays)
+                n += arr.count();
+            sink = n;
+        });
+        run("pool count_all", num_members, [&] { sink = pool.count_all()[0]; });
+        run("pool vector<BitArray> &= mask", num_members, [&] {
+            for (BitArray &arr : arrays)
+                arr &= mask;
+        });
+        run("pool and_all", num_members, [&] { pool.and_all(mask); });
+    }
+
+    // top-10 search over a million 256-bit codes by the scan, the batched scan on all threads and multi-index hashing of near-duplicate codes, the throughput is counted in codes compared
+    void bench_hamming()
+    {
+        const int num_codes = 1 << 20;
+        const int num_bits = 256;
+        const int num_queries = 64;
+        Xoshiro256 rng(15);
+        HammingIndex scan(num_bits);
+        HammingIndex hashed(num_bits, 8);
+        std::vector<BitArray> centres(num_codes / 64, BitArray(num_bits));
+        std::vector<BitArray> queries;
+
+        for (BitArray &c : centres)
+            c.fill_random(rng);
+
+        for (int k = 0; k < num_codes; ++k)
+        {
+            BitArray code(centres[k % centres.size()]);
+            int bit = static_cast<int>(rng() % num_bits);
+            code.flip_many(&bit, 1); // every code is a near duplicate of one centre
+            scan.add(code);
+            hashed.add(code);
+        }
+
+        for (int q = 0; q < num_queries; ++q)
+        {
+            BitArray query(centres[rng() % centres.size()]);
+            int bits[] = {static_cast<int>(rng() % num_bits), static_cast<int>(rng() % num_bits)};
+            query.flip_many(bits, 2);
+            queries.push_back(query);
+        }
+
+        const long long ops = static_cast<long long>(num_codes) * num_queries;
+
+        run("hamming scan top-10", ops, [&] {
+            long long n = 0;
+            for (const BitArray &query : queries)
+                n += scan.search(query, 10)[0].distance;
+            sink = n;
+        });
+        run("hamming batched scan top-10 (all threads)", ops, [&] { sink = scan.search(queries, 10)[0][0].distance; });
+        run("hamming multi-index top-10", ops, [&] {
+            long long n = 0;
+            for (const BitArray &query : queries)
+                n += hashed.search(query, 10)[0].distance;
+            sink = n;
+        });
+    }
+
+    // updates of 16 random bits published by a deep copy of the whole array against the copy-on-write blocks of SharedBitArray, and random reads through a snapshot, the throughput is counted in updates and reads
+    void bench_snapshot()
+    {
+        const int num_bits = 1 << 26;
+        const int num_updates = 200;
+        const int num_reads = 1 << 24;
+        std::vector<std::uint64_t> keys = make_keys(num_updates * 16, 17);
+        std::vector<std::uint64_t> reads = make_keys(num_reads, 18);
+        BitArray arr(num_bits);
+        SharedBitArray shared(num_bits);
+        std::shared_ptr<const BitArray> published = std::make_shared<const BitArray>(arr);
+
+        run("snapshot deep copy per update", num_updates, [&] {
+            for (int u = 0; u < num_updates; ++u)
+            {
+                std::shared_ptr<BitArray> next = std::make_shared<BitArray>(*published);
+                for (int k = 0; k < 16; ++k)
+                    next->set(static_cast<int>(keys[u * 16 + k] % num_bits));
+                published = std::move(next);
+            }
+        });
+        run("snapshot copy-on-write publish", num_updates, [&] {
+            for (int u = 0; u < num_updates; ++u)
+            {
+                for (int k = 0; k < 16; ++k)
+                    shared.set(static_cast<int>(keys[u * 16 + k] % num_bits));
+                shared.publish();
+            }
+        });
+        run("snapshot take", num_reads, [&] {
+            long long n = 0;
+            for (int i = 0; i < num_reads; ++i)
+                n += shared.snapshot().size();
+            sink = n;
+        });
+
+        BitArraySnapshot s = shared.snapshot();
+
+        run("snapshot random operator[]", num_reads, [&] {
+            long long n = 0;
+            for (std::uint64_t key : reads)
+                n += s[static_cast<int>(key % num_bits)];
+            sink = n;
+        });
+        run("snapshot BitArray random operator[]", num_reads, [&] {
+            long long n = 0;
+            for (std::uint64_t key : reads)
+                n += (*published)[static_cast<int>(key % num_bits)];
+            sink = n;
+        });
+    }
+
+    // any and all over a large array by a word loop against the reduced lanes, and count after every set with and without the cached count, the throughput is counted in words and sets
+    void bench_any()
+    {
+        const int num_bits = 1 << 26;
+        const int words = num_bits / 64;
+        const int repeats = 20;
+        const int num_sets = 1 << 20;
+        std::vector<std::uint64_t> keys = make_keys(num_sets, 19);
+        BitArray zeros(num_bits);
+        BitArray ones(num_bits);
+        ones.set();
+
+        run("any word loop (all false)", static_cast<long long>(words) * repeats, [&] {
+            long long n = 0;
+            for (int r = 0; r < repeats; ++r)
+            {
+                const unsigned long *w = static_cast<const BitArray &>(zeros).data();
+                bool found = false;
+                for (int i = 0; i < words && !found; ++i)
+                    found = w[i] != 0UL;
+                n += found;
+            }
+            sink = n;
+        });
+        run("any (all false)", static_cast<long long>(words) * repeats, [&] {
+            long long n = 0;
+            for (int r = 0; r < repeats; ++r)
+                n += zeros.any();
+            sink = n;
+        });
+        run("all (all true)", static_cast<long long>(words) * repeats, [&] {
+            long long n = 0;
+            for (int r = 0; r < repeats; ++r)
+                n += ones.all();
+            sink = n;
+        });
+
+        BitArray small(1 << 16);
+
+        run("any set + count", num_sets, [&] {
+            long long n = 0;
+            for (std::uint64_t key : keys)
+                n += small.set(static_cast<int>(key % (1 << 16)), key & 1).count();
+            sink = n;
+        });
+
+        small.cache_count();
+
+        run("any set + count (cached)", num_sets, [&] {
+            long long n = 0;
+            for (std::uint64_t key : keys)
+                n += small.set(static_cast<int>(key % (1 << 16)), key & 1).count();
+            sink = n;
+        });
+    }
+
+    // sequential set and operator[] and random set through the inline accessors of an array of type Array, the throughput is counted in bits
+    template <typename Array>
+    void bench_word_accessors(const std::string &prefix, const std::vector<std::uint64_t> &keys)
+    {
+        const int num_bits = 1 << 24;
+        Array arr(num_bits);
+
+        run((prefix + " set sequential").c_str(), num_bits, [&] {
+            for (int i = 0; i < num_bits; ++i)
+                arr.set(i, (i & 3) == 0);
+        });
+        run((prefix + " operator[] sequential").c_str(), num_bits, [&] {
+            long long n = 0;
+            for (int i = 0; i < num_bits; ++i)
+                n += arr[i];
+            sink = n;
+        });
+        run((prefix + " set random").c_str(), keys.size(), [&] {
+            for (std::uint64_t key : keys)
+                arr.set(static_cast<int>(key % num_bits));
+        });
+        run((prefix + " count").c_str(), num_bits, [&] {
+            sink = arr.count();
+        });
+    }
+
+    // the accessors of BitArray against those of BasicBitArray with the other word types
+    void bench_accessors()
+    {
+        std::vector<std::uint64_t> keys = make_keys(1 << 24, 16);
+
+        bench_word_accessors<BitArray>("accessors", keys);
+        bench_word_accessors<BasicBitArray<std::uint8_t>>("accessors <uint8_t>", keys);
+        bench_word_accessors<BasicBitArray<std::uint32_t>>("accessors <uint32_t>", keys);
+        bench_word_accessors<BasicBitArray<unsigned long long>>("accessors <unsigned long long>", keys); // std::uint64_t is BitArray itself on LP64
+#if defined(__SIZEOF_INT128__)
+        bench_word_accessors<BasicBitArray<unsigned __int128>>("accessors <unsigned __int128>", keys);
+#endif
+    }
+
+    // random set and operator[] on the largest array with the heap and the huge-page placements, the construction is timed as one operation
+    void bench_placement()
+    {
+        const int num_bits = 0x7FFFFFC0; // 256 MiB, the largest size an int can hold
+        const int num_ops = 1 << 24;
+        std::vector<std::uint64_t> keys = make_keys(num_ops, 9);
+        const Placement placements[] = {Placement::heap, Placement::huge_pages, Placement::interleaved};
+        const char *names[] = {"heap", "huge_pages", "interleaved"};
+
+        for (int p = 0; p < 3; ++p)
+        {
+            std::string prefix = std::string("placement ") + names[p];
+            BitArray arr;
+
+            run((prefix + " construct").c_str(), 1, [&] {
+                BitArray new_object(num_bits, placements[p]);
+                arr.swap(new_object);
+            });
+
+            arr.set(); // every page is touched before the random access is timed
+
+            run((prefix + " random set").c_str(), num_ops, [&] {
+                for (std::uint64_t key : keys)
+                    arr.reset(static_cast<int>(key % num_bits));
+            });
+            run((prefix + " random get").c_str(), num_ops, [&] {
+                long long n = 0;
+                for (std::uint64_t key : keys)
+                    n += arr[static_cast<int>((key >> 17) % num_bits)];
+                sink = n;
+            });
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = argc > 1 ? argv[1] : ""; // runs only the benchmark groups whose name contains the argument
+
+    struct Group
+    {
+        const char *name;
+        void (*run)();
+    } groups[] = {
+        {"bloomfilter", bench_bloomfilter},
+        {"bitmatrix", bench_bitmatrix},
+        {"arithmetic", bench_arithmetic},
+        {"stream", bench_stream},
+        {"codec", bench_codec},
+        {"bsi", bench_bitsliced_index},
+        {"indices", bench_indices},
+        {"random", bench_random},
+        {"shift", bench_shift},
+        {"bitap", bench_bitap},
+        {"pool", bench_pool},
+        {"hamming", bench_hamming},
+        {"accessors", bench_accessors},
+        {"snapshot", bench_snapshot},
+        {"any", bench_any},
+        {"placement", bench_placement},
+    };
+
+    for (const Group &group : groups)
+    {
+        if (std::strstr(group.name, filter) != nullptr)
+            group.run();
+    }
+
+    return 0;
+}
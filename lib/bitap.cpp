@@ -0,0 +1,297 @@
+#include "bitap.hpp"
+#include "bitarray_words.hpp"
+
+namespace
+{
+    // number of bits in an unsigned long cell
+    const int word_bits = sizeof(unsigned long) * 8;
+
+    // updates the exact state r for one text byte with the pattern mask b, returns the true bits of r at the pattern ends of one word or 0
+    unsigned long step_exact(unsigned long *r, const unsigned long *start, const unsigned long *b, const unsigned long *end, int words)
+    {
+        unsigned long carry = 0;
+        unsigned long hit = 0;
+
+        for (int i = 0; i < words; ++i) // the shift-or step moves every pattern one character forward, every pattern may begin at every byte, the carry moves the top bit into the next word
+        {
+            unsigned long old = r[i];
+            unsigned long v = ((old << 1) | carry | start[i]) & b[i];
+
+            carry = old >> (word_bits - 1);
+            r[i] = v;
+            hit |= v & end[i];
+        }
+
+        return hit;
+    }
+
+    // feeds size bytes to the exact state r of W words held in registers, calls report(t) after the byte t if a pattern ends there, the state is written back at the end
+    template <int W, typename F>
+    void run_exact(unsigned long *r, const unsigned long *const *mask, const unsigned long *start, const unsigned long *end, const char *data, std::size_t size, F report)
+    {
+        unsigned long s[W], st[W], en[W];
+
+        for (int i = 0; i < W; ++i)
+        {
+            s[i] = r[i];
+            st[i] = start[i];
+            en[i] = end[i];
+        }
+
+        for (std::size_t t = 0; t < size; ++t) // a short pattern set keeps its state out of memory, so a byte costs a few dependent instructions
+        {
+            const unsigned long *b = mask[static_cast<unsigned char>(data[t])];
+            unsigned long carry = 0;
+            unsigned long hit = 0;
+
+            for (int i = 0; i < W; ++i)
+            {
+                unsigned long old = s[i];
+
+                s[i] = ((old << 1) | carry | st[i]) & b[i];
+                carry = old >> (word_bits - 1);
+                hit |= s[i] & en[i];
+            }
+
+            if (hit != 0)
+            {
+                for (int i = 0; i < W; ++i)
+                    r[i] = s[i];
+
+                report(t);
+            }
+        }
+
+        for (int i = 0; i < W; ++i)
+            r[i] = s[i];
+    }
+
+    // the largest number of errors, the error levels of the error kernel are kept on the stack
+    const int error_limit = 63;
+
+    // updates the states r[0..levels) of 0 to levels - 1 errors for one text byte with the pattern mask b, with the insertions and deletions if edits is true (Wu-Manber), tail masks the bits of the last word, returns the true bits of the last state at the pattern ends of one word or 0
+    template <bool edits>
+    unsigned long step_errors(unsigned long *const *r, int levels, const unsigned long *start, const unsigned long *b, const unsigned long *end, int words, unsigned long tail)
+    {
+        const int max_levels = error_limit + 1;
+        unsigned long carry_old[max_levels] = {}; // the top bits of the previous words of the old states
+        unsigned long carry_new[max_levels] = {}; // the top bits of the previous words of the new states
+        unsigned long hit = 0;
+
+        for (int i = 0; i < words; ++i) // one pass over the words updates every error level
+        {
+            unsigned long old_prev = 0, shifted_old_prev = 0, shifted_new_prev = 0;
+            unsigned long v = 0;
+
+            for (int j = 0; j < levels; ++j)
+            {
+                unsigned long old = r[j][i];
+                unsigned long shifted_old = (old << 1) | carry_old[j] | start[i];
+
+                v = shifted_old & b[i];
+
+                if (j > 0)
+                {
+                    v |= shifted_old_prev; // a substituted character
+
+                    if (edits)
+                        v |= old_prev | shifted_new_prev; // an inserted text character and a deleted pattern character
+
+                    if (i == words - 1)
+                        v &= tail; // the errors do not spill past the last pattern character
+                }
+
+                r[j][i] = v;
+
+                carry_old[j] = old >> (word_bits - 1);
+                old_prev = old;
+                shifted_old_prev = shifted_old;
+                shifted_new_prev = (v << 1) | carry_new[j] | start[i];
+                carry_new[j] = v >> (word_bits - 1);
+            }
+
+            hit |= v & end[i];
+        }
+
+        return hit;
+    }
+}
+
+// creates a matcher of the patterns with at most k errors of the mode, works only when every pattern is longer than k and k <= 63, exact matching takes k = 0
+BitapMatcher::BitapMatcher(const std::vector<std::string> &patterns, int k, BitapMode mode) : mode(mode), max_errors(k)
+{
+    if (patterns.empty()) // the pattern set check
+    {
+        throw std::invalid_argument("Error: pattern set is empty");
+    }
+
+    if (k < 0 || k > error_limit || (mode == BitapMode::exact && k != 0)) // the argument check
+    {
+        throw std::invalid_argument("Error: argument k expects value in [0, 63], 0 for exact matching");
+    }
+
+    long long total = 0;
+
+    for (const std::string &p : patterns)
+    {
+        if (static_cast<long long>(p.size()) <= k) // a pattern of at most k characters would match everywhere
+        {
+            throw std::invalid_argument("Error: pattern is not longer than k");
+        }
+
+        total += p.size();
+    }
+
+    if (total > (1LL << 30)) // the size check
+    {
+        throw std::invalid_argument("Error: patterns are too long");
+    }
+
+    const int num_bits = static_cast<int>(total);
+
+    this->masks.assign(256, BitArray(num_bits));
+    this->starts = BitArray(num_bits);
+    this->ends = BitArray(num_bits);
+
+    int pos = 0;
+
+    for (const std::string &p : patterns) // the patterns are laid back to back, the shift carries the last character of a pattern into the first one of the next, where it is overwritten by the start bit
+    {
+        this->starts.set(pos);
+
+        for (std::size_t i = 0; i < p.size(); ++i)
+            this->masks[static_cast<unsigned char>(p[i])].set(pos + static_cast<int>(i));
+
+        pos += static_cast<int>(p.size());
+
+        this->ends.set(pos - 1);
+        this->end_bits.push_back(pos - 1);
+    }
+
+    this->states.assign(k + 1, BitArray(num_bits));
+
+    (*this).reset();
+}
+
+// returns the number of patterns
+int BitapMatcher::num_patterns() const
+{
+    return static_cast<int>(this->end_bits.size());
+}
+
+// returns the number of bytes fed since the last reset
+long long BitapMatcher::position() const
+{
+    return this->consumed;
+}
+
+// forgets the fed bytes, the next byte is the position 0
+void BitapMatcher::reset()
+{
+    this->consumed = 0;
+
+    for (int j = 0; j <= this->max_errors; ++j)
+    {
+        this->states[j].reset();
+
+        if (this->mode == BitapMode::edit)
+        {
+            int first = 0;
+
+            for (int last : this->end_bits) // before any text, the first j characters of every pattern are matched by j deletions
+            {
+                bitarray_words::fill(this->states[j].data(), first, first + j, true);
+                first = last + 1;
+            }
+        }
+    }
+}
+
+// feeds the next size bytes of the stream, appends the matches that end in them to matches, a match may span several calls
+void BitapMatcher::feed(const char *data, std::size_t size, std::vector<BitapMatch> &matches)
+{
+    const int words = (this->starts.size() + word_bits - 1) / word_bits;
+    const int levels = this->max_errors + 1;
+    const unsigned long tail = bitarray_words::low_mask<unsigned long>(this->starts.size() - (words - 1) * word_bits);
+    const unsigned long *start = this->starts.data();
+    const unsigned long *end = this->ends.data();
+    const unsigned long *mask[256];
+
+    for (int c = 0; c < 256; ++c)
+        mask[c] = this->masks[c].data();
+
+    std::vector<unsigned long *> r(levels);
+
+    for (int j = 0; j < levels; ++j)
+        r[j] = this->states[j].data();
+
+    auto report = [&](std::size_t t) {
+        for (int i = 0; i < words; ++i)
+        {
+            for (unsigned long w = r[levels - 1][i] & end[i]; w != 0UL; w &= w - 1)
+            {
+                int bit = i * word_bits + bitarray_words::ctz(w);
+                int pattern = static_cast<int>(std::lower_bound(this->end_bits.begin(), this->end_bits.end(), bit) - this->end_bits.begin());
+
+                matches.push_back({pattern, this->consumed + static_cast<long long>(t) + 1});
+            }
+        }
+    };
+
+    if (this->mode == BitapMode::exact && words <= 4) // the patterns of up to 4 words take the kernel with the state in registers
+    {
+        switch (words)
+        {
+        case 1:
+            run_exact<1>(r[0], mask, start, end, data, size, report);
+            break;
+        case 2:
+            run_exact<2>(r[0], mask, start, end, data, size, report);
+            break;
+        case 3:
+            run_exact<3>(r[0], mask, start, end, data, size, report);
+            break;
+        default:
+            run_exact<4>(r[0], mask, start, end, data, size, report);
+            break;
+        }
+
+        this->consumed += static_cast<long long>(size);
+        return;
+    }
+
+    for (std::size_t t = 0; t < size; ++t)
+    {
+        const unsigned long *b = mask[static_cast<unsigned char>(data[t])];
+        unsigned long hit;
+
+        switch (this->mode) // the kernels are chosen once per byte, the exact one keeps the state in one shift-or-and loop
+        {
+        case BitapMode::exact:
+            hit = step_exact(r[0], start, b, end, words);
+            break;
+        case BitapMode::mismatch:
+            hit = step_errors<false>(r.data(), levels, start, b, end, words, tail);
+            break;
+        default:
+            hit = step_errors<true>(r.data(), levels, start, b, end, words, tail);
+            break;
+        }
+
+        if (hit != 0) // most bytes end no match, so the end bits are scanned only after a hit
+            report(t);
+    }
+
+    this->consumed += static_cast<long long>(size);
+}
+
+// resets the matcher and returns all matches in the text
+std::vector<BitapMatch> BitapMatcher::find_all(const std::string &text)
+{
+    std::vector<BitapMatch> matches;
+
+    (*this).reset();
+    (*this).feed(text.data(), text.size(), matches);
+
+    return matches;
+}
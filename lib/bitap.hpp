@@ -0,0 +1,51 @@
+#ifndef BITAP_HPP
+#define BITAP_HPP
+
+#include "bitarray.hpp"
+
+// kind of errors allowed by BitapMatcher
+enum class BitapMode
+{
+  exact,    // no errors
+  mismatch, // up to k substituted characters, the Hamming distance
+  edit      // up to k substituted, inserted or deleted characters, the Levenshtein distance (Wu-Manber)
+};
+
+// a match reported by BitapMatcher
+struct BitapMatch
+{
+  int pattern{0}; // the index of the matched pattern
+  long long end{0}; // the position in the stream after the last matched character, the match starts at end - pattern length unless characters were inserted or deleted
+};
+
+// multi-pattern Shift-And (bitap) matcher over a byte stream, the patterns are laid back to back in one multi-word state vector per error level, and every text byte updates all patterns with one word-level shift-or-and pass
+class BitapMatcher
+{
+private:
+  BitapMode mode{BitapMode::exact};
+  int max_errors{0};
+  std::vector<BitArray> masks;  // the bit i of masks[c] is true if the character i of the patterns is c
+  BitArray starts;               // the first character of every pattern
+  BitArray ends;                 // the last character of every pattern
+  std::vector<int> end_bits;     // the index of the last character of every pattern, ascending
+  std::vector<BitArray> states;  // the bit i of states[j] is true if the patterns up to the character i match the text so far with at most j errors
+  long long consumed{0};         // the number of bytes fed since the last reset
+
+public:
+  // creates a matcher of the patterns with at most k errors of the mode, works only when every pattern is longer than k and k <= 63, exact matching takes k = 0
+  BitapMatcher(const std::vector<std::string> &patterns, int k = 0, BitapMode mode = BitapMode::exact);
+
+  // returns the number of patterns
+  int num_patterns() const;
+  // returns the number of bytes fed since the last reset
+  long long position() const;
+
+  // forgets the fed bytes, the next byte is the position 0
+  void reset();
+  // feeds the next size bytes of the stream, appends the matches that end in them to matches, a match may span several calls
+  void feed(const char *data, std::size_t size, std::vector<BitapMatch> &matches);
+  // resets the matcher and returns all matches in the text
+  std::vector<BitapMatch> find_all(const std::string &text);
+};
+
+#endif
@@ -1,17 +1,223 @@
 #include "bitarray.hpp"
+#include "bitarray_words.hpp"
 
-// default constructor, creates an empty object of BitArray class
-BitArray::BitArray() : length(0), capacity(0), array(nullptr) {}
+#include <cstring>
+#include <new>
 
-// default destructor, frees the alocated memory
-BitArray::~BitArray()
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // returns the length of the mapping of an array of words, whole huge pages
+    template <typename Word>
+    std::size_t mapped_length(int words)
+    {
+        std::size_t page = BitArray::huge_page_bytes;
+
+        return (static_cast<std::size_t>(words) * sizeof(Word) + page - 1) / page * page;
+    }
+
+#if defined(__linux__)
+    // maps bytes of zero pages aligned to a huge page, returns nullptr if the mapping fails
+    void *map_huge_pages(std::size_t bytes, Placement placement)
+    {
+        const std::size_t page = BitArray::huge_page_bytes;
+
+        char *memory = static_cast<char *>(mmap(nullptr, bytes + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)); // one extra page leaves room to align the start
+
+        if (memory == MAP_FAILED)
+            return nullptr;
+
+        std::size_t head = (page - reinterpret_cast<std::uintptr_t>(memory) % page) % page;
+
+        if (head > 0)
+            munmap(memory, head);
+
+        munmap(memory + head + bytes, page - head); // the unused parts before and after the aligned range are returned
+
+        memory += head;
+
+#if defined(MADV_HUGEPAGE)
+        madvise(memory, bytes, MADV_HUGEPAGE); // a hint, the small pages are used if the huge pages are disabled
+#endif
+
+#if defined(SYS_mbind)
+        if (placement == Placement::interleaved)
+        {
+            const long interleave = 3; // MPOL_INTERLEAVE of <numaif.h>, so that libnuma is not needed
+
+            for (int nodes = 64; nodes >= 2; nodes /= 2) // the node mask wider than the kernel supports is rejected, so narrower masks are tried, the kernel drops the nodes without memory
+            {
+                unsigned long mask = nodes == 64 ? ~0UL : (1UL << nodes) - 1;
+
+                if (syscall(SYS_mbind, memory, bytes, interleave, &mask, static_cast<unsigned long>(nodes) + 1, 0) == 0)
+                    break;
+            }
+        }
+#endif
+
+        return memory;
+    }
+#endif
+}
+
+// returns true if an array of words with the placement is mapped instead of taken from the heap
+template <typename Word>
+bool BasicBitArray<Word>::is_mapped(int words, Placement placement)
+{
+#if defined(__linux__)
+    return placement != Placement::heap && static_cast<std::size_t>(words) * sizeof(Word) >= static_cast<std::size_t>(huge_page_bytes);
+#else
+    return false; // the huge-page placements fall back to the heap
+#endif
+}
+
+// allocates a zero-filled array of words aligned to a cache line, or mapped with the placement if it fills at least one huge page, the allocation is recorded by the instrumentation counters
+template <typename Word>
+Word *BasicBitArray<Word>::allocate(int words, Placement placement)
+{
+    BITARRAY_RECORD_ALLOC(words * sizeof(Word));
+
+#if defined(__linux__)
+    if (is_mapped(words, placement))
+    {
+        void *memory = map_huge_pages(mapped_length<Word>(words), placement); // the kernel zeroes the pages on the first touch, so there is no zero pass
+
+        if (memory == nullptr)
+            throw std::bad_alloc();
+
+        return static_cast<Word *>(memory);
+    }
+#endif
+
+    void *memory = ::operator new[](words * sizeof(Word), std::align_val_t(alignment)); // the alignment lets blocked and SIMD kernels work on whole cache lines
+
+    std::memset(memory, 0, words * sizeof(Word));
+
+    return static_cast<Word *>(memory);
+}
+
+// clears the bits after the last bit of the array, the word-level operations rely on them being false
+template <typename Word>
+void BasicBitArray<Word>::clear_tail()
+{
+    if (this->length % dim != 0)
+    {
+        this->array[this->length / dim] &= bitarray_words::low_mask<Word>(this->length % dim);
+    }
+}
+
+// marks the blocks of the bits [first, last) as changed if the change tracking is enabled, forgets the cached count
+template <typename Word>
+void BasicBitArray<Word>::record_change(long long first, long long last)
+{
+    if (this->extras == nullptr || first >= last)
+        return; // a plain array has nothing to record
+
+    this->extras->num_true.store(-1, std::memory_order_relaxed); // the changed bits are recounted by the next count()
+
+    if (!this->extras->tracking)
+        return;
+
+    std::vector<Word> &changes = this->extras->changes;
+    long long first_block = first / change_block_bits;
+    long long last_block = (last - 1) / change_block_bits;
+
+    if (changes.size() <= static_cast<std::size_t>(last_block / dim))
+    {
+        changes.resize(last_block / dim + 1, Word(0)); // the change bitmap grows with the array
+    }
+
+    if (first_block == last_block)
+        changes[first_block / dim] |= static_cast<Word>(Word(1) << (first_block % dim)); // the single-bit operations change one block
+    else
+        bitarray_words::fill(changes.data(), first_block, last_block + 1, true);
+}
+
+// returns the state of the opt-in features, allocates it on the first call
+template <typename Word>
+typename BasicBitArray<Word>::Extras &BasicBitArray<Word>::extra()
+{
+    if (this->extras == nullptr)
+    {
+        this->extras.reset(new Extras()); // the features start disabled, the memory is the heap memory
+    }
+
+    return *this->extras;
+}
+
+// frees the array memory according to the way it was obtained, the array pointer = nullptr
+template <typename Word>
+void BasicBitArray<Word>::release()
 {
-    delete[] this->array; // the array memory is freed
+    if (this->array != nullptr)
+    {
+        BITARRAY_RECORD_DEALLOC();
+    }
+
+    Storage storage = this->extras == nullptr ? Storage::heap : this->extras->storage;
+
+    if (storage == Storage::adopted)
+    {
+        delete[] reinterpret_cast<std::uint64_t *>(this->array); // the adopted buffer is freed as it was allocated
+    }
+#if defined(__linux__)
+    else if (storage == Storage::mapped)
+    {
+        munmap(this->array, this->extras->mapped_bytes);
+    }
+#endif
+    else if (this->array != nullptr)
+    {
+        ::operator delete[](this->array, std::align_val_t(alignment));
+    }
+
     this->array = nullptr;
+
+    if (this->extras != nullptr)
+    {
+        this->extras->storage = Storage::heap;
+        this->extras->mapped_bytes = 0;
+    }
+}
+
+// frees the array memory and makes new_arr of words allocated with the placement of the array the array of this object
+template <typename Word>
+void BasicBitArray<Word>::take(Word *new_arr, int words)
+{
+    (*this).release(); // the array memory is freed
+
+    this->array = new_arr; // the new array is became the array of this object
+
+    if (is_mapped(words, (*this).memory_placement())) // a mapped placement is set only in the extras, so they exist here
+    {
+        this->extras->storage = Storage::mapped;
+        this->extras->mapped_bytes = mapped_length<Word>(words);
+    }
+}
+
+// default constructor, creates an empty object of BasicBitArray class
+template <typename Word>
+BasicBitArray<Word>::BasicBitArray() : length(0), capacity(0), array(nullptr) {}
+
+// default destructor, frees the alocated memory
+template <typename Word>
+BasicBitArray<Word>::~BasicBitArray()
+{
+    (*this).release(); // the array memory is freed
 }
 
-// parameterized constructor, creates an object of class BitArray with an array of length num_bits, the first values are filled with value
-BitArray::BitArray(int num_bits, unsigned long value) : length(num_bits)
+// parameterized constructor, creates an object of class BasicBitArray with an array of length num_bits, the first values are filled with value, the k-index bit is the bit k of value
+template <typename Word>
+BasicBitArray<Word>::BasicBitArray(int num_bits, Word value) : length(num_bits)
 {
     if (num_bits < 0) // the argument check
     {
@@ -23,34 +229,105 @@ BitArray::BitArray(int num_bits, unsigned long value) : length(num_bits)
         if (num_bits % dim == 0 && num_bits > 0)
             this->capacity = num_bits; // the capacity = num_bits if num_bits can be integer-divided by the dimension
         else
-            this->capacity = ((num_bits / dim) + 1) * dim; // else the capacity takes the size of full unsigned long cells that can hold all bits
+            this->capacity = ((num_bits / dim) + 1) * dim; // else the capacity takes the size of full words that can hold all bits
+
+        this->array = allocate(this->capacity / dim); // the array memory is allocated
+        this->array[0] = value;                       // the k-index bit is set with the bit k of value
+
+        (*this).clear_tail(); // the bits of value after the last bit of the array are cleared
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::construct, this->capacity / dim);
+}
+
+// parameterized constructor, creates an object of class BasicBitArray with an array of length num_bits filled with false, its memory is allocated with the placement now and when the array grows
+template <typename Word>
+BasicBitArray<Word>::BasicBitArray(int num_bits, Placement placement) : length(num_bits)
+{
+    if (num_bits < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument num_bits expects value > 0");
+    }
+
+    if (placement != Placement::heap)
+    {
+        (*this).extra().placement = placement; // the heap placement needs no extras
+    }
+
+    if (num_bits > 0)
+    {
+        this->capacity = (num_bits + dim - 1) / dim * dim; // the capacity takes the size of full words that can hold all bits
 
-        this->array = new unsigned long[this->capacity / dim]{}; // the array memory is allocated
-        this->array[0] = value;
+        (*this).take(allocate(this->capacity / dim, placement), this->capacity / dim); // the array memory is allocated
     }
+
+    BITARRAY_RECORD_OP(BitArrayOp::construct, this->capacity / dim);
 }
 
-// copy constructor, creates an object of class BitArray by copying object b
-BitArray::BitArray(const BitArray &b) : length(b.length), capacity(b.capacity)
+// copy constructor, creates an object of class BasicBitArray by copying object b, the copy has the placement of b
+template <typename Word>
+BasicBitArray<Word>::BasicBitArray(const BasicBitArray &b) : length(b.length), capacity(b.capacity)
 {
+    if (b.memory_placement() != Placement::heap)
+    {
+        (*this).extra().placement = b.memory_placement(); // the copy keeps the placement but not the tracking or the cached count
+    }
+
     if (b.array != nullptr)
     {
-        this->array = new unsigned long[this->capacity / dim]{}; // the array memory is allocated
+        (*this).take(allocate(this->capacity / dim, (*this).memory_placement()), this->capacity / dim); // the array memory is allocated
 
         std::copy(b.array, b.array + (this->capacity / dim), this->array); // the array is filled with elements of the array b
+
+        BITARRAY_RECORD_COPY(this->capacity / dim * sizeof(Word));
     }
+
+    BITARRAY_RECORD_OP(BitArrayOp::copy_construct, this->capacity / dim);
+}
+
+// move constructor, creates an object of class BasicBitArray by taking the memory, the placement, the change tracking and the cached count of object b, b is left an empty array without them
+template <typename Word>
+BasicBitArray<Word>::BasicBitArray(BasicBitArray &&b) noexcept : array(b.array), length(b.length), capacity(b.capacity), extras(std::move(b.extras))
+{
+    b.array = nullptr; // b is a plain empty array, its memory and its extras are owned by this object now
+    b.length = 0;
+    b.capacity = 0;
 }
 
 // swaps the values of two arrays
-void BitArray::swap(BitArray &b)
+template <typename Word>
+void BasicBitArray<Word>::swap(BasicBitArray &b)
 {
+    if (this->extras != nullptr || b.extras != nullptr)
+    {
+        Extras &e = (*this).extra(); // the memory state is exchanged through the extras of both objects, the features stay with the objects
+        Extras &b_e = b.extra();
+
+        std::swap(e.storage, b_e.storage);
+        std::swap(e.placement, b_e.placement);
+        std::swap(e.mapped_bytes, b_e.mapped_bytes);
+    }
+
+    int counted = (*this).cached_count();
+    int b_counted = b.cached_count();
+
     std::swap(this->length, b.length);
     std::swap(this->capacity, b.capacity);
     std::swap(this->array, b.array);
+
+    (*this).record_change(0, this->length); // the tracking stays with the object, so all bits of both arrays changed
+    b.record_change(0, b.length);
+
+    if (this->extras != nullptr) // both objects have extras or none has
+    {
+        this->extras->num_true.store(this->extras->counting ? b_counted : -1, std::memory_order_relaxed); // the count goes with the bits, the caching mode stays with the object
+        b.extras->num_true.store(b.extras->counting ? counted : -1, std::memory_order_relaxed);
+    }
 }
 
 // assignment operator, assigns the values of one array to another array
-BitArray &BitArray::operator=(const BitArray &b)
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::operator=(const BasicBitArray &b)
 {
     if (((*this).empty() && b.empty()) || (!(*this).empty() && !b.empty()))
     {
@@ -63,24 +340,81 @@ BitArray &BitArray::operator=(const BitArray &b)
     this->length = b.length;
     this->capacity = b.capacity;
 
-    delete[] this->array; // old array memory is freed
+    (*this).release(); // old array memory is freed
+
+    BITARRAY_RECORD_OP(BitArrayOp::assign, this->capacity / dim);
 
     if (!b.empty())
     {
-        this->array = new unsigned long[this->capacity / dim]{}; // new array memory is allocated
+        (*this).take(allocate(this->capacity / dim, (*this).memory_placement()), this->capacity / dim); // new array memory is allocated with the placement of this array
 
         std::copy(b.array, b.array + (this->capacity / dim), this->array); // the array is filled with elements of the array b
+
+        BITARRAY_RECORD_COPY(this->capacity / dim * sizeof(Word));
     }
     else
     {
         this->array = nullptr;
     }
 
+    if (this->extras != nullptr)
+        this->extras->num_true.store(this->extras->counting ? 0 : -1, std::memory_order_relaxed); // an empty array has no true bits, the bits of a non-empty one are forgotten by record_change
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// move assignment operator, frees the array and takes the memory and the placement of array b, b is left empty
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::operator=(BasicBitArray &&b)
+{
+    if (this != &b)
+    {
+        int b_counted = b.cached_count();
+
+        if (b.extras != nullptr)
+        {
+            (*this).extra(); // allocated before anything changes, the memory state of b is taken through it
+        }
+
+        (*this).release(); // old array memory is freed
+
+        std::swap(this->array, b.array);
+
+        this->length = b.length;
+        this->capacity = b.capacity;
+        b.length = 0;
+        b.capacity = 0;
+
+        if (b.extras != nullptr)
+        {
+            this->extras->storage = b.extras->storage;
+            this->extras->placement = b.extras->placement;
+            this->extras->mapped_bytes = b.extras->mapped_bytes;
+            b.extras->storage = Storage::heap;
+            b.extras->mapped_bytes = 0;
+            b.extras->num_true.store(b.extras->counting ? 0 : -1, std::memory_order_relaxed); // b is an empty array, so a later push_back keeps the count from 0
+        }
+        else if (this->extras != nullptr)
+        {
+            this->extras->placement = Placement::heap; // the memory of a plain array is the heap memory
+        }
+
+        (*this).record_change(0, this->length); // the tracking stays with the object, so all bits changed
+
+        if (this->extras != nullptr)
+        {
+            this->extras->num_true.store(this->extras->counting ? b_counted : -1, std::memory_order_relaxed); // the count goes with the bits
+        }
+    }
+
     return *this;
 }
 
 // resizes the array, if the array is incremented, the new values are filled with value
-void BitArray::resize(int num_bits, bool value)
+template <typename Word>
+void BasicBitArray<Word>::resize(int num_bits, bool value)
 {
     if (num_bits < 0) // the argument check
     {
@@ -92,6 +426,8 @@ void BitArray::resize(int num_bits, bool value)
     }
     else
     {
+        (*this).forget_count(); // the cut off or the added bits are recounted by the next count()
+
         if ((num_bits % dim == 0 && this->capacity / dim != num_bits / dim) || (num_bits % dim != 0 && this->capacity / dim != num_bits / dim + 1))
         {
             if (num_bits % dim == 0)
@@ -100,10 +436,12 @@ void BitArray::resize(int num_bits, bool value)
             }
             else
             {
-                this->capacity = (num_bits / dim + 1) * dim; // else the capacity takes the size of full unsigned long cells that can hold all bits
+                this->capacity = (num_bits / dim + 1) * dim; // else the capacity takes the size of full words that can hold all bits
             }
 
-            unsigned long *new_arr(new unsigned long[this->capacity / dim]{}); // a new array is created and its memory is alocated
+            Word *new_arr(allocate(this->capacity / dim, (*this).memory_placement())); // a new array is created and its memory is alocated
+
+            BITARRAY_RECORD_REALLOC();
 
             if (!(*this).empty()) // the array empty check
             {
@@ -111,76 +449,237 @@ void BitArray::resize(int num_bits, bool value)
                 {
                     if (this->length % dim == 0)
                     {
-                        std::copy(this->array, this->array + (this->length / dim), new_arr); // if the length can be integer-divided by the dimensionon, the new array is filled with full unsigned long cells only
+                        std::copy(this->array, this->array + (this->length / dim), new_arr); // if the length can be integer-divided by the dimensionon, the new array is filled with full words only
+
+                        BITARRAY_RECORD_COPY(this->length / dim * sizeof(Word));
                     }
                     else
                     {
-                        std::copy(this->array, this->array + (this->length / dim + 1), new_arr); // else the new array is also filled with an incomplete unsigned long cell
+                        std::copy(this->array, this->array + (this->length / dim + 1), new_arr); // else the new array is also filled with an incomplete word
+
+                        BITARRAY_RECORD_COPY((this->length / dim + 1) * sizeof(Word));
                     }
                 }
                 else
                 {
                     if (num_bits % dim == 0)
                     {
-                        std::copy(this->array, this->array + (num_bits / dim), new_arr); // if the length can be integer-divided by the dimensionon, the new array is filled with full unsigned long cells only
+                        std::copy(this->array, this->array + (num_bits / dim), new_arr); // if the length can be integer-divided by the dimensionon, the new array is filled with full words only
+
+                        BITARRAY_RECORD_COPY(num_bits / dim * sizeof(Word));
                     }
                     else
                     {
-                        std::copy(this->array, this->array + (num_bits / dim + 1), new_arr); // else the new array is also filled with an incomplete unsigned long cell
+                        std::copy(this->array, this->array + (num_bits / dim + 1), new_arr); // else the new array is also filled with an incomplete word
+
+                        BITARRAY_RECORD_COPY((num_bits / dim + 1) * sizeof(Word));
                     }
                 }
             }
 
-            delete[] this->array;  // the array memory is freed
-            this->array = new_arr; // the new array is became the array of this object
+            (*this).take(new_arr, this->capacity / dim); // the array memory is freed and the new array is became the array of this object
         }
 
+        BITARRAY_RECORD_OP(BitArrayOp::resize, this->capacity / dim);
+
         int old_length = this->length;
 
         this->length = num_bits;
 
-        for (int i = old_length; i < this->length; ++i)
+        (*this).clear_tail(); // the cut off bits of the last word are cleared
+
+        if (old_length < this->length)
         {
-            (*this).set(i, value); // free cells are set with the value argument
+            bitarray_words::fill(this->array, old_length, this->length, value); // free cells are set with the value argument
+
+            (*this).record_change(old_length, this->length);
         }
     }
 }
 
 // frees the alocated memory
-void BitArray::clear()
+template <typename Word>
+void BasicBitArray<Word>::clear()
 {
     this->length = 0;
     this->capacity = 0;
+    if (this->extras != nullptr)
+        this->extras->num_true.store(this->extras->counting ? 0 : -1, std::memory_order_relaxed); // an empty array has no true bits, so push_back keeps the count from 0
 
-    delete[] this->array;  // the array memory is freed
-    this->array = nullptr; // the array pointer = nullptr
+    (*this).release(); // the array memory is freed, the array pointer = nullptr
 }
 
 // adds a new value to the end of the array
-void BitArray::push_back(bool bit)
+template <typename Word>
+void BasicBitArray<Word>::push_back(bool bit)
 {
     if (this->length == this->capacity)
     {
         this->capacity += dim;
 
-        unsigned long *new_arr(new unsigned long[this->capacity / dim]{}); // if the array is full, new array memory is allocated
+        Word *new_arr(allocate(this->capacity / dim, (*this).memory_placement())); // if the array is full, new array memory is allocated
+
+        BITARRAY_RECORD_REALLOC();
 
         if (!(*this).empty()) // the array empty check
         {
             std::copy(this->array, this->array + (this->length / dim), new_arr); // the new array is filled with elements of the old array
+
+            BITARRAY_RECORD_COPY(this->length / dim * sizeof(Word));
         }
 
-        delete[] this->array;  // the array memory is freed
-        this->array = new_arr; // the new array is became the array of this object
+        (*this).take(new_arr, this->capacity / dim); // the array memory is freed and the new array is became the array of this object
     }
 
+    BITARRAY_RECORD_OP(BitArrayOp::push_back, 1);
+
     this->length++;
 
     (*this).set(this->length - 1, bit); // the last sell is set with the bit argument
 }
 
+// returns a new object with len bits of the array starting at the pos-index bit
+template <typename Word>
+BasicBitArray<Word> BasicBitArray<Word>::extract(int pos, int len) const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (pos < 0 || len < 0 || pos > this->length - len) // the range validitation check
+    {
+        throw std::out_of_range("Error: range is out of range");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::extract, (len + dim - 1) / dim);
+
+    BasicBitArray new_object(len);
+
+    bitarray_words::copy(new_object.array, 0, this->array, pos, len); // the bits are copied a word at a time with funnel shifts for an unaligned pos
+
+    return new_object;
+}
+
+// inserts the bits of b before the pos-index bit, storage grows at most once
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::insert(int pos, const BasicBitArray &b)
+{
+    if (pos < 0 || pos > this->length) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    if (b.empty())
+    {
+        return *this; // nothing to insert
+    }
+
+    if (&b == this)
+    {
+        BasicBitArray copy(b); // the inserted bits are saved before the array is moved
+
+        return (*this).insert(pos, copy);
+    }
+
+    int new_length = this->length + b.length;
+    int words = (new_length + dim - 1) / dim;
+
+    BITARRAY_RECORD_OP(BitArrayOp::insert, words);
+
+    if (words > this->capacity / dim)
+    {
+        Word *new_arr(allocate(words, (*this).memory_placement())); // the storage grows once for the whole inserted block
+
+        BITARRAY_RECORD_REALLOC();
+        BITARRAY_RECORD_COPY((this->length + dim - 1) / dim * sizeof(Word));
+
+        bitarray_words::copy(new_arr, 0, this->array, 0, pos);                                      // the bits before pos stay in place
+        bitarray_words::copy(new_arr, pos + b.length, this->array, pos, this->length - pos); // the bits after pos are moved behind the inserted block
+
+        (*this).take(new_arr, words); // the array memory is freed and the new array is became the array of this object
+        this->capacity = words * dim;
+    }
+    else
+    {
+        bitarray_words::copy(this->array, pos + b.length, this->array, pos, this->length - pos); // the bits after pos are moved to the right in place
+    }
+
+    bitarray_words::copy(this->array, pos, b.array, 0, b.length); // the inserted block is copied into the gap
+
+    this->length = new_length;
+
+    (*this).record_change(pos, new_length);
+
+    return *this;
+}
+
+// removes the bits [first, last) and closes the gap
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::erase(int first, int last)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (first < 0 || first > last || last > this->length) // the range validitation check
+    {
+        throw std::out_of_range("Error: range is out of range");
+    }
+
+    if (first == last)
+    {
+        return *this; // nothing to erase
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::erase, (this->length + dim - 1) / dim);
+
+    bitarray_words::copy(this->array, first, this->array, last, this->length - last); // the bits after the range are moved to the left in place
+
+    int new_length = this->length - (last - first);
+
+    if (new_length == 0)
+    {
+        (*this).clear(); // if the whole array is erased, the array is cleared
+    }
+    else
+    {
+        bitarray_words::fill(this->array, new_length, this->length, false); // the freed bits at the end are cleared
+        this->length = new_length;
+
+        (*this).record_change(first, new_length);
+    }
+
+    return *this;
+}
+
+// overwrites the bits starting at the pos-index bit with the bits of b
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::replace(int pos, const BasicBitArray &b)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (pos < 0 || pos > this->length - b.length) // the range validitation check
+    {
+        throw std::out_of_range("Error: range is out of range");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::replace, (b.length + dim - 1) / dim);
+
+    bitarray_words::copy(this->array, pos, b.array, 0, b.length); // the bits are copied a word at a time, b may be this array
+
+    (*this).record_change(pos, pos + b.length);
+
+    return *this;
+}
+
 // bitwise multiplication, works only when array sizes match, result is assigned to the object
-BitArray &BitArray::operator&=(const BitArray &b)
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::operator&=(const BasicBitArray &b)
 {
     if ((*this).empty()) // the array empty check
     {
@@ -197,417 +696,1759 @@ BitArray &BitArray::operator&=(const BitArray &b)
         throw std::runtime_error("Error: array sizes do not match");
     }
 
+    BITARRAY_RECORD_OP(BitArrayOp::bit_and, (this->length + dim - 1) / dim);
+
     if (this->length % dim == 0)
     {
         for (int i = 0; i < this->length / dim; ++i)
         {
-            this->array[i] &= b.array[i]; // applying the operation to full unsigned long cells only
+            this->array[i] &= b.array[i]; // applying the operation to full words only
         }
     }
     else
     {
         for (int i = 0; i < this->length / dim + 1; ++i)
         {
-            this->array[i] &= b.array[i]; // applying the operation also to an incomplete unsigned long cell
+            this->array[i] &= b.array[i]; // applying the operation also to an incomplete word
+        }
+    }
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// bitwise addition, works only when array sizes match, result is assigned to the object
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::operator|=(const BasicBitArray &b)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: this array is empty");
+    }
+
+    if (b.empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: other array is empty");
+    }
+
+    if (this->length != b.length) // the array sizes check
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::bit_or, (this->length + dim - 1) / dim);
+
+    if (this->length % dim == 0)
+    {
+        for (int i = 0; i < this->length / dim; ++i)
+        {
+            this->array[i] |= b.array[i]; // applying the operation to full words only
+        }
+    }
+    else
+    {
+        for (int i = 0; i < this->length / dim + 1; ++i)
+        {
+            this->array[i] |= b.array[i]; // applying the operation also to an incomplete word
+        }
+    }
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// exclusive-or, works only when array sizes match, result is assigned to the object
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::operator^=(const BasicBitArray &b)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: this array is empty");
+    }
+
+    if (b.empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: other array is empty");
+    }
+
+    if (this->length != b.length) // the array sizes check
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::bit_xor, (this->length + dim - 1) / dim);
+
+    if (this->length % dim == 0)
+    {
+        for (int i = 0; i < this->length / dim; ++i)
+        {
+            this->array[i] ^= b.array[i]; // applying the operation to full words only
+        }
+    }
+    else
+    {
+        for (int i = 0; i < this->length / dim + 1; ++i)
+        {
+            this->array[i] ^= b.array[i]; // applying the operation also to an incomplete word
+        }
+    }
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// combines every word of the array with the word of b shifted to the left by k (to the right by -k if k < 0) by op, works only when array sizes match
+template <typename Word>
+template <typename Op>
+BasicBitArray<Word> &BasicBitArray<Word>::combine_shifted(const BasicBitArray &b, int k, BitArrayOp stats_op, Op op)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: this array is empty");
+    }
+
+    if (b.empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: other array is empty");
+    }
+
+    if (this->length != b.length) // the array sizes check
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    (void)stats_op; // only read by the instrumentation counters
+
+    BITARRAY_RECORD_OP(stats_op, (this->length + dim - 1) / dim);
+
+    if (k >= 0)
+        bitarray_words::shift_down_combine(this->array, b.array, this->capacity / dim, k, op); // the shifted word is built with a funnel shift and combined right away
+    else
+        bitarray_words::shift_up_combine(this->array, b.array, this->capacity / dim, -static_cast<long long>(k), op);
+
+    (*this).clear_tail(); // the bits shifted past the last bit of the array are cleared
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// bitwise addition with b shifted to the left by k (to the right by -k if k < 0), as *this |= b << k in one pass without a temporary, works only when array sizes match, b may be this array
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::or_shifted(const BasicBitArray &b, int k)
+{
+    return (*this).combine_shifted(b, k, BitArrayOp::bit_or, [](Word a, Word s) { return static_cast<Word>(a | s); });
+}
+
+// bitwise multiplication with b shifted to the left by k (to the right by -k if k < 0), as *this &= b << k in one pass without a temporary, works only when array sizes match, b may be this array
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::and_shifted(const BasicBitArray &b, int k)
+{
+    return (*this).combine_shifted(b, k, BitArrayOp::bit_and, [](Word a, Word s) { return static_cast<Word>(a & s); });
+}
+
+// exclusive-or with b shifted to the left by k (to the right by -k if k < 0), as *this ^= b << k in one pass without a temporary, works only when array sizes match, b may be this array
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::xor_shifted(const BasicBitArray &b, int k)
+{
+    return (*this).combine_shifted(b, k, BitArrayOp::bit_xor, [](Word a, Word s) { return static_cast<Word>(a ^ s); });
+}
+
+// clears the bits that are true in b shifted to the left by k (to the right by -k if k < 0), as *this &= ~(b << k) in one pass without a temporary, works only when array sizes match, b may be this array
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::andnot_shifted(const BasicBitArray &b, int k)
+{
+    return (*this).combine_shifted(b, k, BitArrayOp::bit_andnot, [](Word a, Word s) { return static_cast<Word>(a & ~s); });
+}
+
+// bit shift to the left by n, the freed cells are filled with the value false, result is assigned to the object
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::operator<<=(int n)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (n < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument n expects value > 0");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::shift_left, (this->length + dim - 1) / dim);
+
+    bitarray_words::shift_down(this->array, this->array, this->capacity / dim, n); // the array is shifted to the left by n positions a word at a time
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// bit shift to the right by n, the freed cells are filled with the value false, result is assigned to the object
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::operator>>=(int n)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (n < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument n expects value > 0");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::shift_right, (this->length + dim - 1) / dim);
+
+    bitarray_words::shift_up(this->array, this->array, this->capacity / dim, n); // the array is shifted to the right by n positions a word at a time
+
+    (*this).clear_tail(); // the bits shifted out of the array are cleared
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// bit shift to the left by n, the freed cells are filled with the value false, returns a new object
+template <typename Word>
+BasicBitArray<Word> BasicBitArray<Word>::operator<<(int n) const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (n < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument n expects value > 0");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::shift_left, (this->length + dim - 1) / dim);
+
+    BasicBitArray new_object(this->length);
+
+    bitarray_words::shift_down(new_object.array, this->array, this->capacity / dim, n); // the new array is filled with the array shifted to the left by n positions
+
+    return new_object;
+}
+
+// bit shift to the right by n, the freed cells are filled with the value false, returns a new object
+template <typename Word>
+BasicBitArray<Word> BasicBitArray<Word>::operator>>(int n) const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (n < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument n expects value > 0");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::shift_right, (this->length + dim - 1) / dim);
+
+    BasicBitArray new_object(this->length);
+
+    bitarray_words::shift_up(new_object.array, this->array, this->capacity / dim, n); // the new array is filled with the array shifted to the right by n positions
+
+    new_object.clear_tail(); // the bits shifted out of the array are cleared
+
+    return new_object;
+}
+
+// cyclic shift to the left by n, the bits shifted out at the beginning enter at the end, result is assigned to the object
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::rotate_left(int n)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (n < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument n expects value > 0");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::rotate, (this->length + dim - 1) / dim);
+
+    bitarray_words::rotate(this->array, 0, this->length, n % this->length); // the array is rotated in place by block swaps of whole words
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// cyclic shift to the right by n, the bits shifted out at the end enter at the beginning, result is assigned to the object
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::rotate_right(int n)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (n < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument n expects value > 0");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::rotate, (this->length + dim - 1) / dim);
+
+    bitarray_words::rotate(this->array, 0, this->length, (this->length - n % this->length) % this->length); // the rotation to the right by n is the rotation to the left by length - n
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// cyclic shift to the left by n, the bits shifted out at the beginning enter at the end, returns a new object
+template <typename Word>
+BasicBitArray<Word> BasicBitArray<Word>::rotl(int n) const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (n < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument n expects value > 0");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::rotate, (this->length + dim - 1) / dim);
+
+    n %= this->length;
+
+    BasicBitArray new_object(this->length);
+
+    bitarray_words::copy(new_object.array, 0, this->array, n, this->length - n);      // the bits after the n-index bit are moved to the beginning
+    bitarray_words::copy(new_object.array, this->length - n, this->array, 0, n); // the first n bits are moved to the end
+
+    return new_object;
+}
+
+// cyclic shift to the right by n, the bits shifted out at the end enter at the beginning, returns a new object
+template <typename Word>
+BasicBitArray<Word> BasicBitArray<Word>::rotr(int n) const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (n < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument n expects value > 0");
+    }
+
+    return (*this).rotl((this->length - n % this->length) % this->length); // the rotation to the right by n is the rotation to the left by length - n
+}
+
+// adds b to the array as unsigned integers with the 0-index bit lowest, modulo 2^size(), works only when array sizes match, returns the carry out of the last bit
+template <typename Word>
+bool BasicBitArray<Word>::add(const BasicBitArray &b)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: this array is empty");
+    }
+
+    if (b.empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: other array is empty");
+    }
+
+    if (this->length != b.length) // the array sizes check
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    int words = (this->length + dim - 1) / dim;
+    unsigned char carry = 0;
+
+    BITARRAY_RECORD_OP(BitArrayOp::arithmetic, words);
+
+    for (int i = 0; i < words; ++i)
+    {
+        this->array[i] = bitarray_words::add_carry(this->array[i], b.array[i], carry); // the carry flag is passed from word to word
+    }
+
+    if (this->length % dim != 0)
+    {
+        carry = static_cast<unsigned char>((this->array[words - 1] >> (this->length % dim)) & 1U); // both incomplete last words are below 2^(length % dim), so the carry out of the last bit is the next bit of the sum
+
+        (*this).clear_tail();
+    }
+
+    (*this).record_change(0, this->length);
+
+    return carry != 0;
+}
+
+// subtracts b from the array as unsigned integers with the 0-index bit lowest, modulo 2^size(), works only when array sizes match, returns the borrow out of the last bit
+template <typename Word>
+bool BasicBitArray<Word>::sub(const BasicBitArray &b)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: this array is empty");
+    }
+
+    if (b.empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: other array is empty");
+    }
+
+    if (this->length != b.length) // the array sizes check
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    int words = (this->length + dim - 1) / dim;
+    unsigned char borrow = 0;
+
+    BITARRAY_RECORD_OP(BitArrayOp::arithmetic, words);
+
+    for (int i = 0; i < words; ++i)
+    {
+        this->array[i] = bitarray_words::sub_borrow(this->array[i], b.array[i], borrow); // the borrow flag is passed from word to word
+    }
+
+    (*this).clear_tail(); // a borrow out of the incomplete last word also fills its bits after the last bit
+
+    (*this).record_change(0, this->length);
+
+    return borrow != 0;
+}
+
+// adds 1 to the array as an unsigned integer, returns true if the array wrapped around to zero
+template <typename Word>
+bool BasicBitArray<Word>::increment()
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    int words = (this->length + dim - 1) / dim;
+
+    BITARRAY_RECORD_OP(BitArrayOp::arithmetic, 1);
+
+    for (int i = 0; i < words; ++i)
+    {
+        (*this).record_change(static_cast<long long>(i) * dim, std::min(static_cast<long long>(i + 1) * dim, static_cast<long long>(this->length)));
+
+        if (++this->array[i] != 0) // the carry stops at the first word that does not wrap around
+        {
+            if (i == words - 1 && this->length % dim != 0 && (this->array[i] >> (this->length % dim)) != 0)
+            {
+                (*this).clear_tail(); // the incomplete last word wrapped around at the last bit
+                return true;
+            }
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// replaces the array with its two's complement, the value 2^size() - value modulo 2^size()
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::negate()
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    int words = (this->length + dim - 1) / dim;
+    unsigned char borrow = 0;
+
+    BITARRAY_RECORD_OP(BitArrayOp::arithmetic, words);
+
+    for (int i = 0; i < words; ++i)
+    {
+        this->array[i] = bitarray_words::sub_borrow(Word(0), this->array[i], borrow); // 0 - value with the borrow passed from word to word
+    }
+
+    (*this).clear_tail();
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// multiplies the array as an unsigned integer by k modulo 2^size(), returns the bits of the product after the last bit
+template <typename Word>
+Word BasicBitArray<Word>::multiply(Word k)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    int words = (this->length + dim - 1) / dim;
+    Word high = 0; // the high word of the previous product, added to the next word
+
+    BITARRAY_RECORD_OP(BitArrayOp::arithmetic, words);
+
+    for (int i = 0; i < words; ++i)
+    {
+        Word next_high;
+        unsigned char carry = 0;
+
+        this->array[i] = bitarray_words::add_carry(bitarray_words::mul_wide(this->array[i], k, next_high), high, carry);
+        high = static_cast<Word>(next_high + carry); // the product of two words plus a word never overflows two words
+    }
+
+    (*this).record_change(0, this->length);
+
+    if (this->length % dim == 0)
+        return high;
+
+    int r = this->length % dim;
+    Word overflow = static_cast<Word>((this->array[words - 1] >> r) | (high << (dim - r))); // the value is below 2^length and k below 2^dim, so the bits after the last bit fit in one word
+
+    (*this).clear_tail();
+
+    return overflow;
+}
+
+// compares the arrays as unsigned integers with the 0-index bit lowest, returns -1, 0 or 1, works only when array sizes match
+template <typename Word>
+int BasicBitArray<Word>::compare(const BasicBitArray &b) const
+{
+    if ((*this).empty() && b.empty())
+        return 0;
+
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: this array is empty");
+    }
+
+    if (b.empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: other array is empty");
+    }
+
+    if (this->length != b.length) // the array sizes check
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::compare, (this->length + dim - 1) / dim);
+
+    for (int i = (this->length + dim - 1) / dim - 1; i >= 0; --i) // the highest differing word decides
+    {
+        if (this->array[i] != b.array[i])
+            return this->array[i] < b.array[i] ? -1 : 1;
+    }
+
+    return 0;
+}
+
+// fills the array with true values
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::set()
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::set, this->capacity / dim);
+
+    for (int i = 0; i < this->capacity / dim; ++i)
+    {
+        this->array[i] |= static_cast<Word>(~Word(0)); // the array is filled with negated bits false
+    }
+
+    (*this).clear_tail(); // the bits after the last bit of the array stay false
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+// fills the array with false values
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::reset()
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::reset, this->capacity / dim);
+
+    for (int i = 0; i < this->capacity / dim; ++i)
+    {
+        this->array[i] &= Word(0); // the array is filled with bits false
+    }
+
+    (*this).record_change(0, this->length);
+
+    return *this;
+}
+
+namespace
+{
+    // the distance in indices at which the words of unsorted batches are prefetched
+    const int prefetch_distance = 16;
+
+    // checks the batch of indices once, returns true if the indices are sorted in ascending order
+    bool check_indices(const int *indices, int num, int length)
+    {
+        if (num < 0) // the argument check
+        {
+            throw std::invalid_argument("Error: argument num expects value >= 0");
+        }
+
+        if (indices == nullptr && num > 0) // the index array check
+        {
+            throw std::invalid_argument("Error: index array is null");
+        }
+
+        bool sorted = true;
+        int min = 0;
+        int max = 0;
+
+        for (int i = 0; i < num; ++i)
+        {
+            min = (i == 0 || indices[i] < min) ? indices[i] : min;
+            max = (i == 0 || indices[i] > max) ? indices[i] : max;
+            sorted = sorted && (i == 0 || indices[i - 1] <= indices[i]);
+        }
+
+        if (num > 0 && (min < 0 || max >= length)) // the index validitation check for the whole batch
+        {
+            throw std::out_of_range("Error: index is out of range");
+        }
+
+        return sorted;
+    }
+
+    // applies op(word, mask) to the words of the bits at the indices, sorted batches apply one combined mask per word, with toggle a repeated index cancels out
+    template <typename Word, typename Op>
+    void apply_indices(Word *array, const int *indices, int num, bool sorted, bool toggle, Op op)
+    {
+        const int dim = sizeof(Word) * 8;
+
+        if (sorted)
+        {
+            int i = 0;
+
+            while (i < num)
+            {
+                int word = indices[i] / dim;
+                Word mask = 0;
+
+                for (; i < num && indices[i] / dim == word; ++i)
+                {
+                    Word bit = static_cast<Word>(Word(1) << (indices[i] % dim));
+
+                    mask = toggle ? mask ^ bit : mask | bit; // the bits of one word are coalesced into one mask
+                }
+
+                op(array[word], mask);
+            }
+        }
+        else
+        {
+            for (int i = 0; i < num; ++i)
+            {
+                if (i + prefetch_distance < num)
+                {
+                    bitarray_words::prefetch(array + indices[i + prefetch_distance] / dim); // the word of a random index is requested ahead of its use
+                }
+
+                op(array[indices[i] / dim], static_cast<Word>(Word(1) << (indices[i] % dim)));
+            }
+        }
+    }
+}
+
+// sets the bits at num indices to true, all indices are checked before the array is changed
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::set_many(const int *indices, int num)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    bool sorted = check_indices(indices, num, this->length);
+
+    BITARRAY_RECORD_OP(BitArrayOp::batch, num);
+
+    apply_indices(this->array, indices, num, sorted, false, [](Word &w, Word mask) { w |= mask; });
+
+    if (num > 0)
+        (*this).forget_count(); // the changed bits are recounted by the next count(), with the tracking enabled or not
+
+    for (int i = 0; (*this).tracking_changes() && i < num; ++i)
+    {
+        (*this).record_change(indices[i], indices[i] + 1); // the changed blocks are marked only when the tracking is enabled
+    }
+
+    return *this;
+}
+
+// sets the bits at num indices to false, all indices are checked before the array is changed
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::reset_many(const int *indices, int num)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    bool sorted = check_indices(indices, num, this->length);
+
+    BITARRAY_RECORD_OP(BitArrayOp::batch, num);
+
+    apply_indices(this->array, indices, num, sorted, false, [](Word &w, Word mask) { w &= static_cast<Word>(~mask); });
+
+    if (num > 0)
+        (*this).forget_count(); // the changed bits are recounted by the next count(), with the tracking enabled or not
+
+    for (int i = 0; (*this).tracking_changes() && i < num; ++i)
+    {
+        (*this).record_change(indices[i], indices[i] + 1); // the changed blocks are marked only when the tracking is enabled
+    }
+
+    return *this;
+}
+
+// inverts the bits at num indices, a repeated index inverts the bit again, all indices are checked before the array is changed
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::flip_many(const int *indices, int num)
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    bool sorted = check_indices(indices, num, this->length);
+
+    BITARRAY_RECORD_OP(BitArrayOp::batch, num);
+
+    apply_indices(this->array, indices, num, sorted, true, [](Word &w, Word mask) { w ^= mask; });
+
+    if (num > 0)
+        (*this).forget_count(); // the changed bits are recounted by the next count(), with the tracking enabled or not
+
+    for (int i = 0; (*this).tracking_changes() && i < num; ++i)
+    {
+        (*this).record_change(indices[i], indices[i] + 1); // the changed blocks are marked only when the tracking is enabled
+    }
+
+    return *this;
+}
+
+// writes the values of the bits at num indices to out
+template <typename Word>
+void BasicBitArray<Word>::test_many(const int *indices, int num, bool *out) const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    check_indices(indices, num, this->length);
+
+    BITARRAY_RECORD_OP(BitArrayOp::batch, num);
+
+    for (int i = 0; i < num; ++i)
+    {
+        if (i + prefetch_distance < num)
+        {
+            bitarray_words::prefetch(this->array + indices[i + prefetch_distance] / dim); // the word of a later index is requested ahead of its use
+        }
+
+        out[i] = ((this->array[indices[i] / dim] >> (indices[i] % dim)) & 1U) != 0U;
+    }
+}
+
+namespace
+{
+    // returns true if one of the n words is not 0, the words are OR-reduced a chunk at a time with an exit after every chunk
+    template <typename Word>
+    bool any_word(const Word *words, int n)
+    {
+        int i = 0;
+
+#if defined(__AVX512F__)
+        if constexpr (sizeof(Word) == 8) // the vector lanes hold 64-bit words
+        {
+            for (; i + 32 <= n; i += 32) // four 512-bit lanes, 256 bytes per exit test
+            {
+                __m512i acc = _mm512_or_si512(_mm512_or_si512(_mm512_loadu_si512(words + i), _mm512_loadu_si512(words + i + 8)),
+                                              _mm512_or_si512(_mm512_loadu_si512(words + i + 16), _mm512_loadu_si512(words + i + 24)));
+
+                if (_mm512_test_epi64_mask(acc, acc) != 0)
+                    return true;
+            }
+        }
+#elif defined(__AVX2__)
+        if constexpr (sizeof(Word) == 8) // the vector lanes hold 64-bit words
+        {
+            for (; i + 16 <= n; i += 16) // four 256-bit lanes, 128 bytes per exit test
+            {
+                const __m256i *p = reinterpret_cast<const __m256i *>(words + i);
+                __m256i acc = _mm256_or_si256(_mm256_or_si256(_mm256_loadu_si256(p), _mm256_loadu_si256(p + 1)),
+                                              _mm256_or_si256(_mm256_loadu_si256(p + 2), _mm256_loadu_si256(p + 3)));
+
+                if (!_mm256_testz_si256(acc, acc))
+                    return true;
+            }
+        }
+#endif
+
+        for (; i + 8 <= n; i += 8) // the fixed-size reduction is vectorised by the compiler on any target
+        {
+            Word acc = 0;
+
+            for (int j = 0; j < 8; ++j)
+                acc |= words[i + j];
+
+            if (acc != 0)
+                return true;
+        }
+
+        for (; i < n; ++i)
+        {
+            if (words[i] != 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    // returns true if all bits of the n words are true, the words are AND-reduced a chunk at a time with an exit after every chunk
+    template <typename Word>
+    bool all_words(const Word *words, int n)
+    {
+        int i = 0;
+
+#if defined(__AVX512F__)
+        if constexpr (sizeof(Word) == 8) // the vector lanes hold 64-bit words
+        {
+            for (; i + 32 <= n; i += 32) // four 512-bit lanes, 256 bytes per exit test
+            {
+                __m512i acc = _mm512_and_si512(_mm512_and_si512(_mm512_loadu_si512(words + i), _mm512_loadu_si512(words + i + 8)),
+                                               _mm512_and_si512(_mm512_loadu_si512(words + i + 16), _mm512_loadu_si512(words + i + 24)));
+
+                if (_mm512_cmpneq_epi64_mask(acc, _mm512_set1_epi64(-1)) != 0)
+                    return false;
+            }
+        }
+#elif defined(__AVX2__)
+        if constexpr (sizeof(Word) == 8) // the vector lanes hold 64-bit words
+        {
+            for (; i + 16 <= n; i += 16) // four 256-bit lanes, 128 bytes per exit test
+            {
+                const __m256i *p = reinterpret_cast<const __m256i *>(words + i);
+                __m256i acc = _mm256_and_si256(_mm256_and_si256(_mm256_loadu_si256(p), _mm256_loadu_si256(p + 1)),
+                                               _mm256_and_si256(_mm256_loadu_si256(p + 2), _mm256_loadu_si256(p + 3)));
+
+                if (!_mm256_testc_si256(acc, _mm256_set1_epi64x(-1))) // testc is 1 if acc has every bit of the all-ones mask
+                    return false;
+            }
+        }
+#endif
+
+        for (; i + 8 <= n; i += 8) // the fixed-size reduction is vectorised by the compiler on any target
+        {
+            Word acc = static_cast<Word>(~Word(0));
+
+            for (int j = 0; j < 8; ++j)
+                acc &= words[i + j];
+
+            if (acc != static_cast<Word>(~Word(0)))
+                return false;
+        }
+
+        for (; i < n; ++i)
+        {
+            if (words[i] != static_cast<Word>(~Word(0)))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+// return true if the array contains one or more true bits
+template <typename Word>
+bool BasicBitArray<Word>::any() const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    int counted = (*this).cached_count();
+
+    if (counted >= 0)
+        return counted > 0; // the cached count answers without a scan
+
+    BITARRAY_RECORD_OP(BitArrayOp::any, (this->length + dim - 1) / dim);
+
+    return any_word(this->array, this->capacity / dim); // the bits after the last bit of the array are always false
+}
+
+// returns true if all bits of the array are false
+template <typename Word>
+bool BasicBitArray<Word>::none() const
+{
+    return !(*this).any(); // returns negated any
+}
+
+// returns true if all bits of the array are true
+template <typename Word>
+bool BasicBitArray<Word>::all() const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    int counted = (*this).cached_count();
+
+    if (counted >= 0)
+        return counted == this->length; // the cached count answers without a scan
+
+    BITARRAY_RECORD_OP(BitArrayOp::all, (this->length + dim - 1) / dim);
+
+    const int full = this->length / dim;
+    const int rest = this->length % dim;
+
+    if (!all_words(this->array, full)) // the full words are AND-reduced
+        return false;
+
+    return rest == 0 || this->array[full] == bitarray_words::low_mask<Word>(rest); // the incomplete cell is compared with the mask of its bits
+}
+
+// bitwise inversion, returns a new object
+template <typename Word>
+BasicBitArray<Word> BasicBitArray<Word>::operator~() const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    BITARRAY_RECORD_OP(BitArrayOp::bit_not, this->capacity / dim);
+
+    BasicBitArray new_object(this->length);
+
+    for (int i = 0; i < this->capacity / dim; ++i)
+    {
+        new_object.array[i] = ~this->array[i]; // the new array is filled with negated elements of the old array
+    }
+
+    new_object.clear_tail(); // the negated bits after the last bit of the array are cleared
+
+    return new_object;
+}
+
+// counts the number of true bits
+template <typename Word>
+int BasicBitArray<Word>::count() const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    int counted = (*this).cached_count();
+
+    if (counted >= 0)
+        return counted; // the count is cached and up to date
+
+    BITARRAY_RECORD_OP(BitArrayOp::count, (this->length + dim - 1) / dim);
+
+    int count = 0;
+
+    for (int i = 0; i < this->capacity / dim; ++i)
+    {
+        count += bitarray_words::popcount(this->array[i]); // counting true values in each word
+    }
+
+    if ((*this).caching_count())
+        this->extras->num_true.store(count, std::memory_order_relaxed); // the next count is O(1) until a change other than set, reset or push_back
+
+    return count;
+}
+
+namespace
+{
+#if defined(__AVX512VBMI2__) && defined(__AVX512BW__)
+    // writes the n byte positions base + pos[j] to out as 32-bit indices, 16 lanes per store, up to 15 elements after the n-th may be overwritten, n <= 64 and the caller guard k + 64 <= total keep every store inside out
+    void widen_positions(const unsigned char *pos, int n, std::uint32_t base, std::uint32_t *out)
+    {
+        for (int j = 0; j < n; j += 16)
+        {
+            __m512i v = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos + j)));
+            _mm512_storeu_si512(out + j, _mm512_add_epi32(v, _mm512_set1_epi32(static_cast<int>(base))));
+        }
+    }
+
+    // writes the n byte positions base + pos[j] to out as 64-bit indices, 8 lanes per store, up to 7 elements after the n-th may be overwritten, n <= 64 and the caller guard k + 64 <= total keep every store inside out
+    void widen_positions(const unsigned char *pos, int n, std::uint64_t base, std::uint64_t *out)
+    {
+        for (int j = 0; j < n; j += 8)
+        {
+            __m512i v = _mm512_cvtepu8_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pos + j)));
+            _mm512_storeu_si512(out + j, _mm512_add_epi64(v, _mm512_set1_epi64(static_cast<long long>(base))));
+        }
+    }
+#elif defined(__AVX2__)
+    // the positions of the true bits of every byte value, padded with zeros to 8 bytes
+    struct BytePositions
+    {
+        alignas(8) unsigned char positions[256][8];
+    };
+
+    // builds the byte positions once for all byte values
+    BytePositions make_byte_positions()
+    {
+        BytePositions table;
+
+        for (int b = 0; b < 256; ++b)
+        {
+            int n = 0;
+
+            for (int j = 0; j < 8; ++j)
+                table.positions[b][j] = 0;
+
+            for (int j = 0; j < 8; ++j)
+            {
+                if ((b >> j) & 1)
+                    table.positions[b][n++] = static_cast<unsigned char>(j);
+            }
+        }
+
+        return table;
+    }
+
+    // returns the byte positions, they are built on the first call
+    const BytePositions &byte_positions()
+    {
+        static const BytePositions table = make_byte_positions();
+
+        return table;
+    }
+
+    // writes the positions of the true bits of the byte plus base to out as 32-bit indices with one 8-lane store
+    void expand_byte(unsigned char byte, std::uint32_t base, std::uint32_t *out)
+    {
+        __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(byte_positions().positions[byte])));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), _mm256_add_epi32(v, _mm256_set1_epi32(static_cast<int>(base))));
+    }
+
+    // writes the positions of the true bits of the byte plus base to out as 64-bit indices with two 4-lane stores
+    void expand_byte(unsigned char byte, std::uint64_t base, std::uint64_t *out)
+    {
+        const unsigned char *positions = byte_positions().positions[byte];
+        __m256i offset = _mm256_set1_epi64x(static_cast<long long>(base));
+
+        std::uint32_t low, high;
+        std::memcpy(&low, positions, 4);
+        std::memcpy(&high, positions + 4, 4);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), _mm256_add_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(low))), offset));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 4), _mm256_add_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(high))), offset));
+    }
+#endif
+
+    // writes the indices of the true bits of the words to out, total is the number of true bits, the vector kernels write whole vectors and run while 64 more elements fit into out
+    template <typename Word, typename Index>
+    int decode_indices(const Word *words, int num_words, int total, Index *out)
+    {
+        const int dim = sizeof(Word) * 8;
+        int k = 0;
+        int i = 0;
+
+#if defined(__AVX512VBMI2__) && defined(__AVX512BW__)
+        if constexpr (sizeof(Word) == 8) // the compress mask takes one bit per byte position of a 64-bit word
+        {
+            const __m512i identity = _mm512_set_epi64(0x3F3E3D3C3B3A3938LL, 0x3736353433323130LL, 0x2F2E2D2C2B2A2928LL, 0x2726252423222120LL,
+                                                      0x1F1E1D1C1B1A1918LL, 0x1716151413121110LL, 0x0F0E0D0C0B0A0908LL, 0x0706050403020100LL);
+            alignas(64) unsigned char pos[64];
+
+            for (; i < num_words && k + 64 <= total; ++i)
+            {
+                unsigned long long w = words[i];
+                int n = bitarray_words::popcount(w);
+
+                if (n == 0)
+                    continue;
+
+                if (n <= 4) // a sparse word is faster with a few ctz steps
+                {
+                    for (; w != 0; w &= w - 1)
+                        out[k++] = static_cast<Index>(static_cast<long long>(i) * dim + bitarray_words::ctz(w));
+                    continue;
+                }
+
+                _mm512_store_si512(pos, _mm512_maskz_compress_epi8(w, identity)); // the byte positions of the true bits are packed to the front with one instruction
+                widen_positions(pos, n, static_cast<Index>(static_cast<long long>(i) * dim), out + k);
+                k += n;
+            }
+        }
+#elif defined(__AVX2__)
+        if constexpr (sizeof(Word) <= 8) // a word of at most 64 bits fits the 64 elements of room
+        {
+            for (; i < num_words && k + 64 <= total; ++i)
+            {
+                unsigned long long w = words[i];
+
+                for (int b = 0; w != 0; ++b, w >>= 8) // every byte of the word is expanded through the lookup table
+                {
+                    unsigned char byte = static_cast<unsigned char>(w);
+
+                    if (byte == 0)
+                        continue;
+
+                    expand_byte(byte, static_cast<Index>(static_cast<long long>(i) * dim + 8 * b), out + k);
+                    k += bitarray_words::popcount(byte);
+                }
+            }
+        }
+#else
+        (void)total; // only the vector kernels need the bound
+#endif
+
+        for (; i < num_words; ++i) // the last words are decoded with ctz steps, so nothing is written after the last index
+        {
+            for (Word w = words[i]; w != 0; w &= w - 1)
+                out[k++] = static_cast<Index>(static_cast<long long>(i) * dim + bitarray_words::ctz(w));
+        }
+
+        return k;
+    }
+}
+
+// writes the indices of the true bits in ascending order to out, out must have room for count() indices, returns the number of indices written
+template <typename Word>
+int BasicBitArray<Word>::to_indices(std::uint32_t *out) const
+{
+    int total = (*this).count(); // the prior popcount tells the vector kernels how much room is left
+
+    BITARRAY_RECORD_OP(BitArrayOp::indices, (this->length + dim - 1) / dim);
+
+    return decode_indices(this->array, (this->length + dim - 1) / dim, total, out);
+}
+
+// writes the indices of the true bits in ascending order to out, out must have room for count() indices, returns the number of indices written
+template <typename Word>
+int BasicBitArray<Word>::to_indices(std::uint64_t *out) const
+{
+    int total = (*this).count(); // the prior popcount tells the vector kernels how much room is left
+
+    BITARRAY_RECORD_OP(BitArrayOp::indices, (this->length + dim - 1) / dim);
+
+    return decode_indices(this->array, (this->length + dim - 1) / dim, total, out);
+}
+
+// appends the indices of the true bits in ascending order to out, out grows once by count() elements
+template <typename Word>
+void BasicBitArray<Word>::append_indices(std::vector<std::uint32_t> &out) const
+{
+    std::size_t old_size = out.size();
+
+    out.resize(old_size + (*this).count());
+    (*this).to_indices(out.data() + old_size);
+}
+
+// appends the indices of the true bits in ascending order to out, out grows once by count() elements
+template <typename Word>
+void BasicBitArray<Word>::append_indices(std::vector<std::uint64_t> &out) const
+{
+    std::size_t old_size = out.size();
+
+    out.resize(old_size + (*this).count());
+    (*this).to_indices(out.data() + old_size);
+}
+
+// returns the index of the k-index true bit, counting from 0, the words are skipped by their popcounts
+template <typename Word>
+int BasicBitArray<Word>::select(int k) const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    if (k < 0) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    for (int i = 0; i < this->capacity / dim; ++i)
+    {
+        int n = bitarray_words::popcount(this->array[i]);
+
+        if (k < n)
+            return i * dim + bitarray_words::select(this->array[i], k); // the bit is found inside the word without a bit loop
+
+        k -= n;
+    }
+
+    throw std::out_of_range("Error: index is out of range"); // fewer than k + 1 true bits
+}
+
+// returns the placement of the array memory
+template <typename Word>
+Placement BasicBitArray<Word>::memory_placement() const
+{
+    return this->extras == nullptr ? Placement::heap : this->extras->placement;
+}
+
+namespace
+{
+    // returns the k-index 64-bit word of an array of words words, the missing words are read as false
+    template <typename Word>
+    std::uint64_t load_word64(const Word *array, int words, int k)
+    {
+        const int dim = sizeof(Word) * 8;
+
+        if constexpr (dim > 64) // the 64-bit word is a part of one word
+        {
+            const int per_word = dim / 64; // the number of 64-bit words in a word
+
+            return k / per_word < words ? static_cast<std::uint64_t>(array[k / per_word] >> (k % per_word * 64)) : 0;
+        }
+        else
+        {
+            const int per_word = 64 / dim; // the number of words in a 64-bit word
+            std::uint64_t w = 0;
+
+            for (int j = 0; j < per_word && k * per_word + j < words; ++j)
+            {
+                w |= static_cast<std::uint64_t>(array[k * per_word + j]) << (j * dim);
+            }
+
+            return w;
+        }
+    }
+
+    // writes the k-index 64-bit word to an array of words words, the missing words are skipped
+    template <typename Word>
+    void store_word64(Word *array, int words, int k, std::uint64_t w)
+    {
+        const int dim = sizeof(Word) * 8;
+
+        if constexpr (dim > 64) // the 64-bit word replaces a part of one word
+        {
+            const int per_word = dim / 64; // the number of 64-bit words in a word
+            const int shift = k % per_word * 64;
+
+            if (k / per_word < words)
+            {
+                Word &cell = array[k / per_word];
+
+                cell = static_cast<Word>((cell & ~(static_cast<Word>(~std::uint64_t(0)) << shift)) | (static_cast<Word>(w) << shift));
+            }
+        }
+        else
+        {
+            const int per_word = 64 / dim; // the number of words in a 64-bit word
+
+            for (int j = 0; j < per_word && k * per_word + j < words; ++j)
+            {
+                array[k * per_word + j] = static_cast<Word>(w >> (j * dim));
+            }
+        }
+    }
+}
+
+// returns a 64-bit hash of the array mixed from whole words, equal arrays have equal hashes
+template <typename Word>
+std::size_t BasicBitArray<Word>::hash() const
+{
+    const unsigned long long k1 = 0x9E3779B97F4A7C15ULL; // multipliers of the mixing steps
+    const unsigned long long k2 = 0xBF58476D1CE4E5B9ULL;
+    const unsigned long long k3 = 0x94D049BB133111EBULL;
+
+    int words = (this->length + 63) / 64; // the state mixes 64-bit words, so the hash does not depend on the word type
+
+    BITARRAY_RECORD_OP(BitArrayOp::hash, (this->length + dim - 1) / dim);
+
+    unsigned long long h = static_cast<unsigned long long>(this->length) * k1; // the size is mixed in so that arrays of different sizes differ
+
+    for (int i = 0; i < words; ++i)
+    {
+        unsigned long long w = load_word64(this->array, this->capacity / dim, i);
+
+        if (i == words - 1 && this->length % 64 != 0)
+        {
+            w &= bitarray_words::low_mask<std::uint64_t>(this->length % 64); // the padding bits of the last word are masked
         }
+
+        h = (h ^ (w * k2)) * k1; // each word is multiplied and mixed into the state
+        h ^= h >> 29;
     }
 
-    return *this;
+    h ^= h >> 30; // the final avalanche spreads every input bit over the whole hash
+    h *= k2;
+    h ^= h >> 27;
+    h *= k3;
+    h ^= h >> 31;
+
+    return static_cast<std::size_t>(h);
 }
 
-// bitwise addition, works only when array sizes match, result is assigned to the object
-BitArray &BitArray::operator|=(const BitArray &b)
+// returns the array as a string
+template <typename Word>
+std::string BasicBitArray<Word>::to_string() const
 {
     if ((*this).empty()) // the array empty check
     {
-        throw std::invalid_argument("Error: this array is empty");
+        throw std::invalid_argument("Error: array is empty");
     }
 
-    if (b.empty()) // the array empty check
+    BITARRAY_RECORD_OP(BitArrayOp::to_string, (this->length + dim - 1) / dim);
+
+    std::string str("");
+
+    for (int i = 0; i < this->length; ++i)
     {
-        throw std::invalid_argument("Error: other array is empty");
+        if ((*this)[i]) // if the value is true, appends 1 to the end of the string, else appends 0
+            str.append("1");
+        else
+            str.append("0");
     }
 
-    if (this->length != b.length) // the array sizes check
+    return str;
+}
+
+// creates an object of class BasicBitArray of length num_bits from 64-bit words, the n-index bit is the bit n % 64 of the word n / 64
+template <typename Word>
+BasicBitArray<Word> BasicBitArray<Word>::from_words(const std::uint64_t *words, int num_bits)
+{
+    if (num_bits < 0) // the argument check
     {
-        throw std::runtime_error("Error: array sizes do not match");
+        throw std::invalid_argument("Error: argument num_bits expects value > 0");
     }
 
-    if (this->length % dim == 0)
+    BasicBitArray new_object(num_bits);
+
+    for (int k = 0; k < (num_bits + 63) / 64; ++k)
     {
-        for (int i = 0; i < this->length / dim; ++i)
-        {
-            this->array[i] |= b.array[i]; // applying the operation to full unsigned long cells only
-        }
+        store_word64(new_object.array, new_object.capacity / dim, k, words[k]); // each 64-bit word is split into its words or placed into its part of a word
     }
-    else
+
+    if (!new_object.empty())
     {
-        for (int i = 0; i < this->length / dim + 1; ++i)
-        {
-            this->array[i] |= b.array[i]; // applying the operation also to an incomplete unsigned long cell
-        }
+        new_object.clear_tail(); // the bits of the last word after num_bits are dropped
     }
 
-    return *this;
+    return new_object;
 }
 
-// exclusive-or, works only when array sizes match, result is assigned to the object
-BitArray &BitArray::operator^=(const BitArray &b)
+// writes the array to 64-bit words, the n-index bit is the bit n % 64 of the word n / 64, (size() + 63) / 64 words are written
+template <typename Word>
+void BasicBitArray<Word>::to_words(std::uint64_t *words) const
 {
-    if ((*this).empty()) // the array empty check
+    for (int k = 0; k < (this->length + 63) / 64; ++k)
     {
-        throw std::invalid_argument("Error: this array is empty");
+        words[k] = load_word64(this->array, this->capacity / dim, k); // each 64-bit word is gathered from its words or taken from its part of a word
     }
+}
 
-    if (b.empty()) // the array empty check
+namespace
+{
+    // returns true if the host stores words with the lowest byte first
+    bool host_is_little_endian()
     {
-        throw std::invalid_argument("Error: other array is empty");
-    }
+        const std::uint64_t probe = 1;
 
-    if (this->length != b.length) // the array sizes check
-    {
-        throw std::runtime_error("Error: array sizes do not match");
+        return *reinterpret_cast<const unsigned char *>(&probe) == 1;
     }
 
-    if (this->length % dim == 0)
-    {
-        for (int i = 0; i < this->length / dim; ++i)
-        {
-            this->array[i] ^= b.array[i]; // applying the operation to full unsigned long cells only
-        }
-    }
-    else
+    // returns the position of the byte k of a byte stream of num_bytes bytes in the little-endian order of its 8-byte group
+    int little_endian_position(int k, int num_bytes, ByteOrder byte_order)
     {
-        for (int i = 0; i < this->length / dim + 1; ++i)
-        {
-            this->array[i] ^= b.array[i]; // applying the operation also to an incomplete unsigned long cell
-        }
-    }
+        if (byte_order == ByteOrder::little)
+            return k;
 
-    return *this;
+        int group = k / 8 * 8;
+        int group_size = std::min(8, num_bytes - group); // the last group may be incomplete
+
+        return group + group_size - 1 - (k - group); // the bytes of a group are reversed
+    }
 }
 
-// bit shift to the left by n, the freed cells are filled with the value false, result is assigned to the object
-BitArray &BitArray::operator<<=(int n)
+// creates an object of class BasicBitArray of length num_bits from (num_bits + 7) / 8 bytes in the given byte and bit order
+template <typename Word>
+BasicBitArray<Word> BasicBitArray<Word>::from_bytes(const unsigned char *bytes, int num_bits, ByteOrder byte_order, BitOrder bit_order)
 {
-    if ((*this).empty()) // the array empty check
+    if (num_bits < 0) // the argument check
     {
-        throw std::invalid_argument("Error: array is empty");
+        throw std::invalid_argument("Error: argument num_bits expects value > 0");
     }
 
-    if (n < 0) // the argument check
+    BasicBitArray new_object(num_bits);
+
+    int num_bytes = (num_bits + 7) / 8;
+
+    if (num_bytes == 0)
     {
-        throw std::invalid_argument("Error: argument n expects value > 0");
+        return new_object;
     }
 
-    if (n >= this->length)
+    if (byte_order == ByteOrder::little && bit_order == BitOrder::lsb_first && host_is_little_endian())
     {
-        (*this).reset(); // if the argument is greater than the array length, the array is filled with the value false
+        std::copy(bytes, bytes + num_bytes, reinterpret_cast<unsigned char *>(new_object.array)); // the stream has the memory layout of the array and is copied at once
     }
     else
     {
-        for (int i = n; i < this->length; ++i)
+        for (int k = 0; k < num_bytes; ++k)
         {
-            (*this).set(i - n, (*this)[i]); // the array is shifted to the left by n positions
-        }
+            unsigned char byte = bytes[k];
 
-        for (int i = this->length - n; i < this->length; ++i)
-        {
-            (*this).set(i, false); // empty cells are filled with the value false
+            if (bit_order == BitOrder::msb_first)
+                byte = bitarray_words::reverse(byte); // the bits of the byte are put into the LSB-first order
+
+            int pos = little_endian_position(k, num_bytes, byte_order) * 8;
+
+            new_object.array[pos / new_object.dim] |= static_cast<Word>(byte) << (pos % new_object.dim); // the byte is placed into its word
         }
     }
 
-    return *this;
+    new_object.clear_tail(); // the bits of the last byte after num_bits are dropped
+
+    return new_object;
 }
 
-// bit shift to the right by n, the freed cells are filled with the value false, result is assigned to the object
-BitArray &BitArray::operator>>=(int n)
+// writes the array to (size() + 7) / 8 bytes in the given byte and bit order, the bits after the last bit are false
+template <typename Word>
+void BasicBitArray<Word>::to_bytes(unsigned char *bytes, ByteOrder byte_order, BitOrder bit_order) const
 {
-    if ((*this).empty()) // the array empty check
+    int num_bytes = (this->length + 7) / 8;
+
+    if (num_bytes == 0)
     {
-        throw std::invalid_argument("Error: array is empty");
+        return;
     }
 
-    if (n < 0) // the argument check
+    if (byte_order == ByteOrder::little && bit_order == BitOrder::lsb_first && host_is_little_endian())
     {
-        throw std::invalid_argument("Error: argument n expects value > 0");
+        const unsigned char *words = reinterpret_cast<const unsigned char *>(this->array);
+
+        std::copy(words, words + num_bytes, bytes); // the memory layout of the array is the requested stream and is copied at once
+        return;
     }
 
-    if (n >= this->length)
+    for (int k = 0; k < num_bytes; ++k)
     {
-        (*this).reset(); // if the argument is greater than the array length, the array is filled with the value false
+        int pos = little_endian_position(k, num_bytes, byte_order) * 8;
+
+        unsigned char byte = static_cast<unsigned char>(this->array[pos / dim] >> (pos % dim)); // the byte is taken from its word
+
+        if (bit_order == BitOrder::msb_first)
+            byte = bitarray_words::reverse(byte); // the bits of the byte are put into the MSB-first order
+
+        bytes[k] = byte;
     }
-    else
+}
+
+// creates an object of class BasicBitArray from the vector, the n-index bit is the n-index element
+template <typename Word>
+BasicBitArray<Word> BasicBitArray<Word>::from_vector(const std::vector<bool> &v)
+{
+    BasicBitArray new_object(static_cast<int>(v.size()));
+
+    const int dim = new_object.dim;
+
+    for (int i = 0; i < new_object.capacity / dim; ++i)
     {
-        for (int i = this->length - n - 1; i >= 0; --i)
-        {
-            (*this).set(i + n, (*this)[i]); // the array is shifted to the right by n positions
-        }
+        Word w = 0;
 
-        for (int i = 0; i < n; ++i)
+        for (int j = 0; j < dim && i * dim + j < new_object.length; ++j)
         {
-            (*this).set(i, false); // empty cells are filled with the value false
+            w |= static_cast<Word>(v[i * dim + j]) << j; // the word is assembled in a register and stored once
         }
+
+        new_object.array[i] = w;
     }
 
-    return *this;
+    return new_object;
 }
 
-// bit shift to the left by n, the freed cells are filled with the value false, returns a new object
-BitArray BitArray::operator<<(int n) const
+// returns the array as a vector, the n-index element is the n-index bit
+template <typename Word>
+std::vector<bool> BasicBitArray<Word>::to_vector() const
 {
-    if ((*this).empty()) // the array empty check
-    {
-        throw std::invalid_argument("Error: array is empty");
-    }
+    std::vector<bool> v(this->length);
 
-    if (n < 0) // the argument check
-    {
-        throw std::invalid_argument("Error: argument n expects value > 0");
-    }
-
-    BitArray new_object(this->length);
-
-    if (n < this->length) // if n is greater than the array lenght, the array remains untouched with the value false in each cell
+    for (int i = 0; i < this->capacity / dim; ++i)
     {
-        for (int i = n; i < this->length; ++i)
-        {
-            new_object.set(i - n, (*this)[i]); // the array is shifted to the left by n positions
-        }
+        Word w = this->array[i];
 
-        for (int i = this->length - n; i < this->length; ++i)
+        for (int j = 0; j < dim && i * dim + j < this->length; ++j)
         {
-            new_object.set(i, false); // empty cells are filled with the value false
+            v[i * dim + j] = ((w >> j) & 1U) != 0U; // each word is loaded once
         }
     }
 
-    return new_object;
+    return v;
 }
 
-// bit shift to the right by n, the freed cells are filled with the value false, returns a new object
-BitArray BitArray::operator>>(int n) const
+// takes ownership of a buffer of (num_bits + 63) / 64 words without copying, the n-index bit is the bit n % 64 of the word n / 64
+template <typename Word>
+void BasicBitArray<Word>::adopt(std::unique_ptr<std::uint64_t[]> words, int num_bits)
 {
-    if ((*this).empty()) // the array empty check
+    if (num_bits < 0) // the argument check
     {
-        throw std::invalid_argument("Error: array is empty");
+        throw std::invalid_argument("Error: argument num_bits expects value > 0");
     }
 
-    if (n < 0) // the argument check
+    if (words == nullptr && num_bits > 0) // the buffer check
     {
-        throw std::invalid_argument("Error: argument n expects value > 0");
+        throw std::invalid_argument("Error: buffer is null");
     }
 
-    BitArray new_object(this->length);
+    if (num_bits == 0)
+    {
+        (*this).clear(); // an empty buffer makes an empty array
+        return;
+    }
 
-    if (n < this->length) // if n is greater than the array lenght, the array remains untouched with the value false in each cell
+    if constexpr (sizeof(Word) != sizeof(std::uint64_t))
     {
-        for (int i = this->length - n - 1; i >= 0; --i)
-        {
-            new_object.set(i + n, (*this)[i]); // the array is shifted to the right by n positions
-        }
+        BasicBitArray new_object = BasicBitArray::from_words(words.get(), num_bits); // the layouts differ, so the buffer is converted and freed
 
-        for (int i = 0; i < n; ++i)
-        {
-            new_object.set(i, false); // empty cells are filled with the value false
-        }
+        (*this).swap(new_object);
+        return;
     }
 
-    return new_object;
+    Extras &e = (*this).extra(); // allocated before the buffer is taken, so a failed allocation leaves the buffer to words
+
+    (*this).release(); // the old array memory is freed
+
+    this->array = reinterpret_cast<Word *>(words.release()); // the buffer becomes the array of this object
+    e.storage = Storage::adopted;
+    BITARRAY_RECORD_ALLOC((num_bits + 63) / 64 * sizeof(std::uint64_t)); // the adoption is counted as an allocation, so the release of the buffer is matched
+    this->length = num_bits;
+    this->capacity = (num_bits + dim - 1) / dim * dim;
+
+    (*this).clear_tail(); // the bits of the last word after num_bits are cleared
+
+    (*this).record_change(0, this->length);
 }
 
-// sets the n-index bit to val
-BitArray &BitArray::set(int n, bool val)
+// creates an object of class BasicBitArray of length num_bits from words stored in the legacy MSB-first order, where the n-index bit was the bit dim - 1 - n % dim of the word n / dim
+template <typename Word>
+BasicBitArray<Word> BasicBitArray<Word>::from_legacy(const Word *words, int num_bits)
 {
-    if ((*this).empty()) // the array empty check
+    if (num_bits < 0) // the argument check
     {
-        throw std::invalid_argument("Error: array is empty");
+        throw std::invalid_argument("Error: argument num_bits expects value > 0");
     }
 
-    if (n < 0 || n >= this->length) // the index validitation check
-    {
-        throw std::out_of_range("Error: index is out of range");
-    }
+    BasicBitArray new_object(num_bits);
 
-    if (val)
+    for (int i = 0; i < new_object.capacity / new_object.dim; ++i)
     {
-        this->array[n / dim] |= 1UL << (dim - ((n + 1) % dim)); // if argument value is true, the unsigned long cell containing the n-index is bitwise added with the bitmask consisting of the true bit shifted to the left
+        new_object.array[i] = bitarray_words::reverse(words[i]); // the legacy order is the reversed order of bits in each word
     }
-    else
+
+    if (!new_object.empty())
     {
-        this->array[n / dim] &= ~(1UL << (dim - ((n + 1) % dim))); // if argument value is false, the unsigned long cell containing the n-index is bitwise multiplied with the bitmask consisting of the negated true bit shifted to the left
+        new_object.clear_tail(); // the padding bits of the legacy data are dropped
     }
 
-    return *this;
+    return new_object;
 }
 
-// fills the array with true values
-BitArray &BitArray::set()
+// writes the array to words in the legacy MSB-first order, (size() + dim - 1) / dim words are written
+template <typename Word>
+void BasicBitArray<Word>::to_legacy(Word *words) const
 {
-    if ((*this).empty()) // the array empty check
-    {
-        throw std::invalid_argument("Error: array is empty");
-    }
-
     for (int i = 0; i < this->capacity / dim; ++i)
     {
-        this->array[i] |= ~0UL; // the array is filled with negated bits false
+        words[i] = bitarray_words::reverse(this->array[i]); // the legacy order is the reversed order of bits in each word
     }
-
-    return *this;
 }
 
-// sets the n-index bit to the value false
-BitArray &BitArray::reset(int n)
+// enables or disables the cached count, while it is enabled count, any, none and all take O(1) after the first count, set, reset and push_back keep the count up to date and the other changes make the next count recount, the changes through data() and spans made after a later count are not seen
+template <typename Word>
+void BasicBitArray<Word>::cache_count(bool enabled)
 {
-    (*this).set(n, false); // the n-index cell is set with the value false
+    if (!enabled && this->extras == nullptr)
+        return; // a plain array caches nothing
 
-    return *this;
+    Extras &e = (*this).extra();
+
+    e.counting = enabled;
+    e.num_true.store(enabled && (*this).empty() ? 0 : -1, std::memory_order_relaxed); // the count is taken again by the next count()
 }
 
-// fills the array with false values
-BitArray &BitArray::reset()
+// returns true if the count is cached
+template <typename Word>
+bool BasicBitArray<Word>::caching_count() const
 {
-    if ((*this).empty()) // the array empty check
-    {
-        throw std::invalid_argument("Error: array is empty");
-    }
+    return this->extras != nullptr && this->extras->counting;
+}
 
-    for (int i = 0; i < this->capacity / dim; ++i)
-    {
-        this->array[i] &= 0UL; // the array is filled with bits false
-    }
+// enables or disables the change tracking, enabling starts with no changes, the changes through data() and spans are not tracked and are marked with mark_changed
+template <typename Word>
+void BasicBitArray<Word>::track_changes(bool enabled)
+{
+    if (!enabled && this->extras == nullptr)
+        return; // a plain array tracks nothing
 
-    return *this;
+    Extras &e = (*this).extra();
+
+    e.tracking = enabled;
+    e.changes.clear();
+    e.changes.shrink_to_fit(); // the change bitmap is allocated again on the first change
 }
 
-// return true if the array contains one or more true bits
-bool BitArray::any() const
+// returns true if the change tracking is enabled
+template <typename Word>
+bool BasicBitArray<Word>::tracking_changes() const
 {
-    if ((*this).empty()) // the array empty check
-    {
-        throw std::invalid_argument("Error: array is empty");
-    }
+    return this->extras != nullptr && this->extras->tracking;
+}
 
-    for (int i = 0; i < this->length / dim; ++i)
+// marks the bits [first, last) as changed, works only when the change tracking is enabled
+template <typename Word>
+void BasicBitArray<Word>::mark_changed(int first, int last)
+{
+    if (!(*this).tracking_changes()) // the tracking check
     {
-        if (this->array[i] > 0UL) // if at least one element of the array is greater than 0, return true
-            return true;
+        throw std::invalid_argument("Error: change tracking is disabled");
     }
 
-    if (this->length % dim == 0)
-    {
-        return false; // if the array consists of full unsigned long cells only and all unsigned long cells are already checked, return false
-    }
-    else
+    if (first < 0 || first > last || last > this->length) // the range validitation check
     {
-        for (int i = this->length - this->length % dim; i < this->length; ++i)
-        {
-            if ((*this)[i]) // else check also an incomplete unsigned long cell, if at least one bit is true, return true
-                return true;
-        }
+        throw std::out_of_range("Error: range is out of range");
     }
 
-    return false; // if all bits are already checked and none of them are true, return false
+    (*this).record_change(first, last);
 }
 
-// returns true if all bits of the array are false
-bool BitArray::none() const
+// forgets the recorded changes, usually after their delta was sent
+template <typename Word>
+void BasicBitArray<Word>::clear_changes()
 {
-    return !(*this).any(); // returns negated any
+    if (this->extras != nullptr)
+        std::fill(this->extras->changes.begin(), this->extras->changes.end(), Word(0));
 }
 
-// bitwise inversion, returns a new object
-BitArray BitArray::operator~() const
+// returns the changes recorded since the tracking was enabled or the changes were cleared, works only when the change tracking is enabled
+template <typename Word>
+BitArrayDelta BasicBitArray<Word>::delta() const
 {
-    if ((*this).empty()) // the array empty check
+    if (!(*this).tracking_changes()) // the tracking check
     {
-        throw std::invalid_argument("Error: array is empty");
+        throw std::invalid_argument("Error: change tracking is disabled");
     }
 
-    BitArray new_object(this->length);
+    const int block_words = change_block_bits / 64; // the number of 64-bit words in a block
+    const int total = (this->length + 63) / 64;   // the number of 64-bit words of the array
 
-    for (int i = 0; i < this->capacity / dim; ++i)
-    {
-        new_object.array[i] = ~this->array[i]; // the new array is filled with negated elements of the old array
-    }
+    BitArrayDelta delta;
+    delta.num_bits = this->length;
 
-    return new_object;
-}
+    const std::vector<Word> &changes = this->extras->changes;
 
-// counts the number of true bits
-int BitArray::count() const
-{
-    if ((*this).empty()) // the array empty check
+    for (std::size_t i = 0; i < changes.size(); ++i)
     {
-        throw std::invalid_argument("Error: array is empty");
-    }
+        for (Word w = changes[i]; w != 0; w &= w - 1) // every iteration takes the lowest changed block of the word
+        {
+            long long block = static_cast<long long>(i) * dim + bitarray_words::ctz(w);
 
-    int count = 0;
+            if (block * block_words >= total) // the blocks after the last bit were cut off by a shrinking operation
+                break;
 
-    for (int i = 0; i < this->length; ++i)
-    {
-        if ((*this)[i]) // counting true values in the array
-            ++count;
+            int first = static_cast<int>(block * block_words);
+            int last = std::min(first + block_words, total);
+
+            if (!delta.ranges.empty() && delta.ranges.back() == first)
+                delta.ranges.back() = last; // adjacent changed blocks are merged into one range
+            else
+            {
+                delta.ranges.push_back(first);
+                delta.ranges.push_back(last);
+            }
+
+            for (int k = first; k < last; ++k)
+                delta.words.push_back(load_word64(this->array, this->capacity / dim, k));
+        }
     }
 
-    return count;
+    return delta;
 }
 
-// returns the value of the i-index bit
-bool BitArray::operator[](int i) const
+// writes the changes of the delta to the array, the array is resized to the size of the delta source first
+template <typename Word>
+BasicBitArray<Word> &BasicBitArray<Word>::apply_delta(const BitArrayDelta &delta)
 {
-    if ((*this).empty()) // the array empty check
+    const int total = (delta.num_bits + 63) / 64;
+    std::size_t num_words = 0;
+
+    if (delta.num_bits < 0 || delta.ranges.size() % 2 != 0) // the delta validitation check
     {
-        throw std::invalid_argument("Error: array is empty");
+        throw std::invalid_argument("Error: delta is malformed");
     }
 
-    if (i < 0 || i >= this->length) // the index validitation check
+    for (std::size_t r = 0; r < delta.ranges.size(); r += 2)
     {
-        throw std::out_of_range("Error: index is out of range");
-    }
+        int first = delta.ranges[r];
+        int last = delta.ranges[r + 1];
 
-    return (this->array[i / dim] & (1UL << (dim - ((i + 1) % dim)))) > 0UL; // the unsigned long cell containing the i-index is bitwise multiplied with the bitmask consisting of the true bit shifted to the left, if the i-index bit is true, unsigned long cell is greater than 0, returns true
-}
+        if (first < (r == 0 ? 0 : delta.ranges[r - 1]) || first >= last || last > total) // the ranges must be ascending and inside the array
+        {
+            throw std::invalid_argument("Error: delta is malformed");
+        }
 
-// returns the array size
-int BitArray::size() const
-{
-    return this->length;
-}
+        num_words += last - first;
+    }
 
-// returns true if memory for the array is not allocated
-bool BitArray::empty() const
-{
-    if (this->array == nullptr) // the allocated memory check
-        return true;
-    else
-        return false;
-}
+    if (num_words != delta.words.size()) // the payload size check
+    {
+        throw std::invalid_argument("Error: delta is malformed");
+    }
 
-// returns the array as a string
-std::string BitArray::to_string() const
-{
-    if ((*this).empty()) // the array empty check
+    if (this->length != delta.num_bits)
     {
-        throw std::invalid_argument("Error: array is empty");
+        (*this).resize(delta.num_bits); // the array follows the size of the delta source
     }
 
-    std::string str("");
+    const std::uint64_t *w = delta.words.data();
 
-    for (int i = 0; i < this->length; ++i)
+    for (std::size_t r = 0; r < delta.ranges.size(); r += 2)
     {
-        if ((*this)[i]) // if the value is true, appends 1 to the end of the string, else appends 0
-            str.append("1");
-        else
-            str.append("0");
+        for (int k = delta.ranges[r]; k < delta.ranges[r + 1]; ++k)
+            store_word64(this->array, this->capacity / dim, k, *w++);
+
+        (*this).record_change(static_cast<long long>(delta.ranges[r]) * 64, std::min(static_cast<long long>(delta.ranges[r + 1]) * 64, static_cast<long long>(this->length))); // a tracked replica passes the changes on
     }
 
-    return str;
+    if (this->length > 0)
+        (*this).clear_tail(); // the payload bits after the last bit are ignored
+
+    return *this;
 }
 
 // equality operator, return true if the arrays are the same, works only when array sizes match
-bool operator==(const BitArray &a, const BitArray &b)
+template <typename Word>
+bool operator==(const BasicBitArray<Word> &a, const BasicBitArray<Word> &b)
 {
+    const int dim = BasicBitArray<Word>::dim;
+
     if (a.empty() && b.empty())
         return true;
 
@@ -626,9 +2467,11 @@ bool operator==(const BitArray &a, const BitArray &b)
         throw std::runtime_error("Error: array sizes do not match");
     }
 
-    for (int i = 0; i < a.size(); ++i)
+    BITARRAY_RECORD_OP(BitArrayOp::compare, (a.size() + dim - 1) / dim);
+
+    for (int i = 0; i < (a.size() + dim - 1) / dim; ++i)
     {
-        if (a[i] != b[i]) // checking equality of each pair of bits in arrays
+        if (a.data()[i] != b.data()[i]) // checking equality of each pair of words in arrays, the bits after the last bit are always false
             return false;
     }
 
@@ -636,14 +2479,38 @@ bool operator==(const BitArray &a, const BitArray &b)
 }
 
 // inequality operator, return true if the arrays are not the same, works only when array sizes match
-bool operator!=(const BitArray &a, const BitArray &b)
+template <typename Word>
+bool operator!=(const BasicBitArray<Word> &a, const BasicBitArray<Word> &b)
 {
     return !(a == b); // returns negated a == b
 }
 
+// less-than operator, orders arrays by size first and then by value with the highest word compared first, works for arrays of any sizes
+template <typename Word>
+bool operator<(const BasicBitArray<Word> &a, const BasicBitArray<Word> &b)
+{
+    const int dim = BasicBitArray<Word>::dim;
+
+    if (a.size() != b.size()) // arrays of different sizes are ordered by size
+        return a.size() < b.size();
+
+    BITARRAY_RECORD_OP(BitArrayOp::compare, (a.size() + dim - 1) / dim);
+
+    for (int i = (a.size() + dim - 1) / dim - 1; i >= 0; --i)
+    {
+        if (a.data()[i] != b.data()[i]) // the first pair of different words from the highest one decides the order
+            return a.data()[i] < b.data()[i];
+    }
+
+    return false;
+}
+
 // bitwise multiplication, works only when array sizes match, returns a new object
-BitArray operator&(const BitArray &b1, const BitArray &b2)
+template <typename Word>
+BasicBitArray<Word> operator&(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2)
 {
+    const int dim = BasicBitArray<Word>::dim;
+
     if (b1.empty()) // the array empty check
     {
         throw std::invalid_argument("Error: first array is empty");
@@ -659,19 +2526,24 @@ BitArray operator&(const BitArray &b1, const BitArray &b2)
         throw std::runtime_error("Error: array sizes do not match");
     }
 
-    BitArray new_object(b1.size());
+    BITARRAY_RECORD_OP(BitArrayOp::bit_and, (b1.size() + dim - 1) / dim);
 
-    for (int i = 0; i < b1.size(); ++i)
+    BasicBitArray<Word> new_object(b1.size());
+
+    for (int i = 0; i < (b1.size() + dim - 1) / dim; ++i)
     {
-        new_object.set(i, b1[i] & b2[i]); // the new array is filled with the result of the & operation with each bit in 2 input arrays
+        new_object.data()[i] = b1.data()[i] & b2.data()[i]; // the new array is filled with the result of the & operation with each pair of words in 2 input arrays
     }
 
     return new_object;
 }
 
 // bitwise addition, works only when array sizes match, returns a new object
-BitArray operator|(const BitArray &b1, const BitArray &b2)
+template <typename Word>
+BasicBitArray<Word> operator|(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2)
 {
+    const int dim = BasicBitArray<Word>::dim;
+
     if (b1.empty()) // the array empty check
     {
         throw std::invalid_argument("Error: first array is empty");
@@ -687,19 +2559,24 @@ BitArray operator|(const BitArray &b1, const BitArray &b2)
         throw std::runtime_error("Error: array sizes do not match");
     }
 
-    BitArray new_object(b1.size());
+    BITARRAY_RECORD_OP(BitArrayOp::bit_or, (b1.size() + dim - 1) / dim);
 
-    for (int i = 0; i < b1.size(); ++i)
+    BasicBitArray<Word> new_object(b1.size());
+
+    for (int i = 0; i < (b1.size() + dim - 1) / dim; ++i)
     {
-        new_object.set(i, b1[i] | b2[i]); // the new array is filled with the result of the | operation with each bit in 2 input arrays
+        new_object.data()[i] = b1.data()[i] | b2.data()[i]; // the new array is filled with the result of the | operation with each pair of words in 2 input arrays
     }
 
     return new_object;
 }
 
 // exclusive-or, works only when array sizes match, returns a new object
-BitArray operator^(const BitArray &b1, const BitArray &b2)
+template <typename Word>
+BasicBitArray<Word> operator^(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2)
 {
+    const int dim = BasicBitArray<Word>::dim;
+
     if (b1.empty()) // the array empty check
     {
         throw std::invalid_argument("Error: first array is empty");
@@ -715,12 +2592,34 @@ BitArray operator^(const BitArray &b1, const BitArray &b2)
         throw std::runtime_error("Error: array sizes do not match");
     }
 
-    BitArray new_object(b1.size());
+    BITARRAY_RECORD_OP(BitArrayOp::bit_xor, (b1.size() + dim - 1) / dim);
 
-    for (int i = 0; i < b1.size(); ++i)
+    BasicBitArray<Word> new_object(b1.size());
+
+    for (int i = 0; i < (b1.size() + dim - 1) / dim; ++i)
     {
-        new_object.set(i, b1[i] ^ b2[i]); // the new array is filled with the result of the ^ operation with each bit in 2 input arrays
+        new_object.data()[i] = b1.data()[i] ^ b2.data()[i]; // the new array is filled with the result of the ^ operation with each pair of words in 2 input arrays
     }
 
     return new_object;
-}
\ No newline at end of file
+}
+// the members and operators are compiled once here for every word type, the header declares them extern
+#define BITARRAY_INSTANTIATE(Word)                                                                     \
+    template class BasicBitArray<Word>;                                                                \
+    template bool operator==(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2);            \
+    template bool operator!=(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2);            \
+    template bool operator<(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2);             \
+    template BasicBitArray<Word> operator&(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2); \
+    template BasicBitArray<Word> operator|(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2); \
+    template BasicBitArray<Word> operator^(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2);
+
+BITARRAY_INSTANTIATE(unsigned char)
+BITARRAY_INSTANTIATE(unsigned short)
+BITARRAY_INSTANTIATE(unsigned int)
+BITARRAY_INSTANTIATE(unsigned long)
+BITARRAY_INSTANTIATE(unsigned long long)
+#if defined(__SIZEOF_INT128__)
+BITARRAY_INSTANTIATE(unsigned __int128)
+#endif
+
+#undef BITARRAY_INSTANTIATE
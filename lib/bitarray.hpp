@@ -1,32 +1,142 @@
+#ifndef BITARRAY_HPP
+#define BITARRAY_HPP
+
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <string>
+#include <functional>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bitarray_stats.hpp"
+
+// order of bytes inside each group of 8 bytes in the byte import and export
+enum class ByteOrder
+{
+  little, // the byte k of a group holds the bits [8k, 8k + 8) of the group
+  big     // the bytes of a group are reversed
+};
+
+// order of bits inside each byte in the byte import and export
+enum class BitOrder
+{
+  lsb_first, // the lowest bit of a byte holds the lowest index
+  msb_first  // the highest bit of a byte holds the lowest index
+};
 
-class BitArray
+// placement of the memory of large arrays, the arrays smaller than one huge page always use the heap
+enum class Placement
 {
+  heap,        // aligned operator new with an explicit zero pass
+  huge_pages,  // 2 MiB-aligned anonymous mapping with MADV_HUGEPAGE, zeroed lazily by the kernel, every page goes to the NUMA node of the thread that first writes it
+  interleaved  // as huge_pages, with the pages spread round-robin over the NUMA nodes by mbind
+};
+
+// changes of a BitArray recorded by the change tracking, the changed ranges of 64-bit words with their new values
+struct BitArrayDelta
+{
+  int num_bits{0};                  // the size of the array when the delta was taken
+  std::vector<int> ranges;          // the pairs first, last of the changed ranges [first, last) of 64-bit words in ascending order
+  std::vector<std::uint64_t> words; // the words of all ranges back to back, the n-index bit is the bit n % 64 of the word n / 64
+};
+
+// array of bits stored in words of the unsigned type Word (std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t or unsigned __int128), the n-index bit is the bit n % dim of the word n / dim (LSB-first), the hot accessors are inline and the other members are defined in bitarray.cpp for every word type
+template <typename Word>
+class BasicBitArray
+{
+  static_assert(static_cast<Word>(-1) > Word(0), "Error: Word expects an unsigned integer type");
+
 private:
-  unsigned long *array{nullptr};
+  // the way the array memory was obtained, defines how it is freed
+  enum class Storage
+  {
+    heap,   // allocated by allocate
+    adopted, // taken over from a std::unique_ptr<std::uint64_t[]> by adopt
+    mapped   // mapped by allocate for a huge-page placement
+  };
+
+  // the state of the opt-in features, allocated on the first use of the change tracking, the cached count, a huge-page placement or adopt, so a plain array holds only its words, length and capacity
+  struct Extras
+  {
+    Storage storage{Storage::heap};
+    Placement placement{Placement::heap}; // the placement of every allocation of the array, kept when the array grows
+    std::size_t mapped_bytes{0};          // the length of the mapping of a mapped array
+    bool tracking{false};
+    bool counting{false};
+    std::atomic<int> num_true{-1};      // the number of true bits while the count is cached and known, -1 otherwise, atomic so that concurrent count() calls may fill it
+    std::vector<Word> changes;          // the bit k is true if the bits [k * change_block_bits, (k + 1) * change_block_bits) changed since the last clear_changes
+  };
+
+  Word *array{nullptr};
   int length{0};
   int capacity{0};
-  const int dim{sizeof(unsigned long) * 8};
+  std::unique_ptr<Extras> extras; // nullptr until an opt-in feature is used
+
+  // allocates a zero-filled array of words aligned to a cache line, or mapped with the placement if it fills at least one huge page, the allocation is recorded by the instrumentation counters
+  static Word *allocate(int words, Placement placement = Placement::heap);
+  // returns true if an array of words with the placement is mapped instead of taken from the heap
+  static bool is_mapped(int words, Placement placement);
+  // returns the state of the opt-in features, allocates it on the first call
+  Extras &extra();
+  // returns the cached count, -1 if the count is not cached or not known
+  int cached_count() const;
+  // forgets the cached count, the next count() recounts
+  void forget_count();
+
+  // frees the array memory according to the way it was obtained, the array pointer = nullptr
+  void release();
+  // frees the array memory and makes new_arr of words allocated with the placement of the array the array of this object
+  void take(Word *new_arr, int words);
+
+  // clears the bits after the last bit of the array, the word-level operations rely on them being false
+  void clear_tail();
+
+  // returns a uniform random word of type Out built from as many draws of rng as it takes, unbiased when the range of rng is a power of two
+  template <typename Out, typename Rng>
+  static Out random_word(Rng &rng);
+
+  // marks the blocks of the bits [first, last) as changed if the change tracking is enabled, forgets the cached count
+  void record_change(long long first, long long last);
+
+  // combines every word of the array with the word of b shifted to the left by k (to the right by -k if k < 0) by op, works only when array sizes match
+  template <typename Op>
+  BasicBitArray &combine_shifted(const BasicBitArray &b, int k, BitArrayOp stats_op, Op op);
 
 public:
-  // default constructor, creates an empty object of BitArray class
-  BitArray();
+  // number of bits in a word
+  static const int dim{sizeof(Word) * 8};
+  // alignment of the allocated word arrays in bytes, one cache line
+  static const int alignment{64};
+  // number of bits covered by one bit of the change tracking, one cache line
+  static const int change_block_bits{512};
+  // size of a huge page in bytes, the alignment and the granularity of the mapped arrays
+  static const int huge_page_bytes{1 << 21};
+
+  // default constructor, creates an empty object of BasicBitArray class
+  BasicBitArray();
   // default destructor, frees the alocated memory
-  ~BitArray();
+  ~BasicBitArray();
 
-  // parameterized constructor, creates an object of class BitArray with an array of length num_bits, the first values are filled with value
-  explicit BitArray(int num_bits, unsigned long value = 0);
-  // copy constructor, creates an object of class BitArray by copying object b
-  BitArray(const BitArray &b);
+  // parameterized constructor, creates an object of class BasicBitArray with an array of length num_bits, the first values are filled with value, the k-index bit is the bit k of value
+  explicit BasicBitArray(int num_bits, Word value = 0);
+  // parameterized constructor, creates an object of class BasicBitArray with an array of length num_bits filled with false, its memory is allocated with the placement now and when the array grows
+  BasicBitArray(int num_bits, Placement placement);
+  // copy constructor, creates an object of class BasicBitArray by copying object b, the copy has the placement of b
+  BasicBitArray(const BasicBitArray &b);
+  // move constructor, creates an object of class BasicBitArray by taking the memory, the placement, the change tracking and the cached count of object b, b is left an empty array without them
+  BasicBitArray(BasicBitArray &&b) noexcept;
 
   // swaps the values of two arrays
-  void swap(BitArray &b);
+  void swap(BasicBitArray &b);
 
   // assignment operator, assigns the values of one array to another array
-  BitArray &operator=(const BitArray &b);
+  BasicBitArray &operator=(const BasicBitArray &b);
+  // move assignment operator, frees the array and takes the memory and the placement of array b, b is left empty
+  BasicBitArray &operator=(BasicBitArray &&b);
 
   // resizes the array, if the array is incremented, the new values are filled with value
   void resize(int num_bits, bool value = false);
@@ -35,61 +145,520 @@ public:
   // adds a new value to the end of the array
   void push_back(bool bit);
 
+  // returns a new object with len bits of the array starting at the pos-index bit
+  BasicBitArray extract(int pos, int len) const;
+  // inserts the bits of b before the pos-index bit, storage grows at most once
+  BasicBitArray &insert(int pos, const BasicBitArray &b);
+  // removes the bits [first, last) and closes the gap
+  BasicBitArray &erase(int first, int last);
+  // overwrites the bits starting at the pos-index bit with the bits of b
+  BasicBitArray &replace(int pos, const BasicBitArray &b);
+
   // bitwise multiplication, works only when array sizes match, result is assigned to the object
-  BitArray &operator&=(const BitArray &b);
+  BasicBitArray &operator&=(const BasicBitArray &b);
   // bitwise addition, works only when array sizes match, result is assigned to the object
-  BitArray &operator|=(const BitArray &b);
+  BasicBitArray &operator|=(const BasicBitArray &b);
   // exclusive-or, works only when array sizes match, result is assigned to the object
-  BitArray &operator^=(const BitArray &b);
+  BasicBitArray &operator^=(const BasicBitArray &b);
 
   // bit shift to the left by n, the freed cells are filled with the value false, result is assigned to the object
-  BitArray &operator<<=(int n);
+  BasicBitArray &operator<<=(int n);
   // bit shift to the right by n, the freed cells are filled with the value false, result is assigned to the object
-  BitArray &operator>>=(int n);
+  BasicBitArray &operator>>=(int n);
   // bit shift to the left by n, the freed cells are filled with the value false, returns a new object
-  BitArray operator<<(int n) const;
+  BasicBitArray operator<<(int n) const;
   // bit shift to the right by n, the freed cells are filled with the value false, returns a new object
-  BitArray operator>>(int n) const;
+  BasicBitArray operator>>(int n) const;
+
+  // bitwise addition with b shifted to the left by k (to the right by -k if k < 0), as *this |= b << k in one pass without a temporary, works only when array sizes match, b may be this array
+  BasicBitArray &or_shifted(const BasicBitArray &b, int k);
+  // bitwise multiplication with b shifted to the left by k (to the right by -k if k < 0), as *this &= b << k in one pass without a temporary, works only when array sizes match, b may be this array
+  BasicBitArray &and_shifted(const BasicBitArray &b, int k);
+  // exclusive-or with b shifted to the left by k (to the right by -k if k < 0), as *this ^= b << k in one pass without a temporary, works only when array sizes match, b may be this array
+  BasicBitArray &xor_shifted(const BasicBitArray &b, int k);
+  // clears the bits that are true in b shifted to the left by k (to the right by -k if k < 0), as *this &= ~(b << k) in one pass without a temporary, works only when array sizes match, b may be this array
+  BasicBitArray &andnot_shifted(const BasicBitArray &b, int k);
+
+  // cyclic shift to the left by n, the bits shifted out at the beginning enter at the end, result is assigned to the object
+  BasicBitArray &rotate_left(int n);
+  // cyclic shift to the right by n, the bits shifted out at the end enter at the beginning, result is assigned to the object
+  BasicBitArray &rotate_right(int n);
+  // cyclic shift to the left by n, the bits shifted out at the beginning enter at the end, returns a new object
+  BasicBitArray rotl(int n) const;
+  // cyclic shift to the right by n, the bits shifted out at the end enter at the beginning, returns a new object
+  BasicBitArray rotr(int n) const;
+
+  // adds b to the array as unsigned integers with the 0-index bit lowest, modulo 2^size(), works only when array sizes match, returns the carry out of the last bit
+  bool add(const BasicBitArray &b);
+  // subtracts b from the array as unsigned integers with the 0-index bit lowest, modulo 2^size(), works only when array sizes match, returns the borrow out of the last bit
+  bool sub(const BasicBitArray &b);
+  // adds 1 to the array as an unsigned integer, returns true if the array wrapped around to zero
+  bool increment();
+  // replaces the array with its two's complement, the value 2^size() - value modulo 2^size()
+  BasicBitArray &negate();
+  // multiplies the array as an unsigned integer by k modulo 2^size(), returns the bits of the product after the last bit
+  Word multiply(Word k);
+  // compares the arrays as unsigned integers with the 0-index bit lowest, returns -1, 0 or 1, works only when array sizes match
+  int compare(const BasicBitArray &b) const;
 
   // sets the n-index bit to val
-  BitArray &set(int n, bool val = true);
+  BasicBitArray &set(int n, bool val = true);
   // fills the array with true values
-  BitArray &set();
+  BasicBitArray &set();
 
   // sets the n-index bit to the value false
-  BitArray &reset(int n);
+  BasicBitArray &reset(int n);
   // fills the array with false values
-  BitArray &reset();
+  BasicBitArray &reset();
+
+  // sets the bits at num indices to true, all indices are checked before the array is changed
+  BasicBitArray &set_many(const int *indices, int num);
+  // sets the bits at num indices to false, all indices are checked before the array is changed
+  BasicBitArray &reset_many(const int *indices, int num);
+  // inverts the bits at num indices, a repeated index inverts the bit again, all indices are checked before the array is changed
+  BasicBitArray &flip_many(const int *indices, int num);
+  // writes the values of the bits at num indices to out
+  void test_many(const int *indices, int num, bool *out) const;
 
   // return true if the array contains one or more true bits
   bool any() const;
   // returns true if all bits of the array are false
   bool none() const;
+  // returns true if all bits of the array are true
+  bool all() const;
   // bitwise inversion, returns a new object
-  BitArray operator~() const;
+  BasicBitArray operator~() const;
   // counts the number of true bits
   int count() const;
 
+  // writes the indices of the true bits in ascending order to out, out must have room for count() indices, returns the number of indices written
+  int to_indices(std::uint32_t *out) const;
+  // writes the indices of the true bits in ascending order to out, out must have room for count() indices, returns the number of indices written
+  int to_indices(std::uint64_t *out) const;
+  // appends the indices of the true bits in ascending order to out, out grows once by count() elements
+  void append_indices(std::vector<std::uint32_t> &out) const;
+  // appends the indices of the true bits in ascending order to out, out grows once by count() elements
+  void append_indices(std::vector<std::uint64_t> &out) const;
+
+  // returns the index of the k-index true bit, counting from 0, the words are skipped by their popcounts
+  int select(int k) const;
+
+  // fills the array with uniform random bits, a whole word at a time, rng is a UniformRandomBitGenerator such as Xoshiro256
+  template <typename Rng>
+  BasicBitArray &fill_random(Rng &rng);
+  // fills the array with random bits that are true with probability p, a word at a time from at most 32 uniform words, so p is rounded down to a multiple of 2^-32
+  template <typename Rng>
+  BasicBitArray &fill_bernoulli(double p, Rng &rng);
+  // returns the index of a true bit chosen uniformly at random
+  template <typename Rng>
+  int random_set_bit(Rng &rng) const;
+
   // returns the value of the i-index bit
   bool operator[](int i) const;
 
   // returns the array size
   int size() const;
+  // returns the placement of the array memory
+  Placement memory_placement() const;
   // returns true if memory for the array is not allocated
   bool empty() const;
 
   // returns the array as a string
   std::string to_string() const;
+
+  // returns a 64-bit hash of the array mixed from whole words, equal arrays have equal hashes
+  std::size_t hash() const;
+
+  // returns a pointer to the words of the array, the n-index bit is the bit n % dim of the word n / dim (LSB-first), the bits after the last bit are false
+  Word *data();
+  // returns a pointer to the words of the array, the n-index bit is the bit n % dim of the word n / dim (LSB-first), the bits after the last bit are false
+  const Word *data() const;
+
+  // creates an object of class BasicBitArray of length num_bits from 64-bit words, the n-index bit is the bit n % 64 of the word n / 64
+  static BasicBitArray from_words(const std::uint64_t *words, int num_bits);
+  // writes the array to 64-bit words, the n-index bit is the bit n % 64 of the word n / 64, (size() + 63) / 64 words are written
+  void to_words(std::uint64_t *words) const;
+
+  // creates an object of class BasicBitArray of length num_bits from (num_bits + 7) / 8 bytes in the given byte and bit order
+  static BasicBitArray from_bytes(const unsigned char *bytes, int num_bits, ByteOrder byte_order = ByteOrder::little, BitOrder bit_order = BitOrder::lsb_first);
+  // writes the array to (size() + 7) / 8 bytes in the given byte and bit order, the bits after the last bit are false
+  void to_bytes(unsigned char *bytes, ByteOrder byte_order = ByteOrder::little, BitOrder bit_order = BitOrder::lsb_first) const;
+
+  // creates an object of class BasicBitArray from the vector, the n-index bit is the n-index element
+  static BasicBitArray from_vector(const std::vector<bool> &v);
+  // returns the array as a vector, the n-index element is the n-index bit
+  std::vector<bool> to_vector() const;
+
+  // creates an object of class BasicBitArray from the bitset, the n-index bit is the bit n of the bitset
+  template <std::size_t N>
+  static BasicBitArray from_bitset(const std::bitset<N> &b);
+  // returns the array as a bitset, the bit n of the bitset is the n-index bit, works only when the sizes match
+  template <std::size_t N>
+  std::bitset<N> to_bitset() const;
+
+  // takes ownership of a buffer of (num_bits + 63) / 64 words without copying, the n-index bit is the bit n % 64 of the word n / 64
+  void adopt(std::unique_ptr<std::uint64_t[]> words, int num_bits);
+
+  // creates an object of class BasicBitArray of length num_bits from words stored in the legacy MSB-first order, where the n-index bit was the bit dim - 1 - n % dim of the word n / dim
+  static BasicBitArray from_legacy(const Word *words, int num_bits);
+  // writes the array to words in the legacy MSB-first order, (size() + dim - 1) / dim words are written
+  void to_legacy(Word *words) const;
+
+  // enables or disables the cached count, while it is enabled count, any, none and all take O(1) after the first count, set, reset and push_back keep the count up to date and the other changes make the next count recount, the changes through data() and spans made after a later count are not seen
+  void cache_count(bool enabled = true);
+  // returns true if the count is cached
+  bool caching_count() const;
+
+  // enables or disables the change tracking, enabling starts with no changes, the changes through data() and spans are not tracked and are marked with mark_changed
+  void track_changes(bool enabled = true);
+  // returns true if the change tracking is enabled
+  bool tracking_changes() const;
+  // marks the bits [first, last) as changed, works only when the change tracking is enabled
+  void mark_changed(int first, int last);
+  // forgets the recorded changes, usually after their delta was sent
+  void clear_changes();
+  // returns the changes recorded since the tracking was enabled or the changes were cleared, works only when the change tracking is enabled
+  BitArrayDelta delta() const;
+  // writes the changes of the delta to the array, the array is resized to the size of the delta source first
+  BasicBitArray &apply_delta(const BitArrayDelta &delta);
 };
 
 // equality operator, return true if the arrays are the same, works only when array sizes match
-bool operator==(const BitArray &a, const BitArray &b);
+template <typename Word>
+bool operator==(const BasicBitArray<Word> &a, const BasicBitArray<Word> &b);
 // inequality operator, return true if the arrays are not the same, works only when array sizes match
-bool operator!=(const BitArray &a, const BitArray &b);
+template <typename Word>
+bool operator!=(const BasicBitArray<Word> &a, const BasicBitArray<Word> &b);
+
+// less-than operator, orders arrays by size first and then by value with the highest word compared first, works for arrays of any sizes
+template <typename Word>
+bool operator<(const BasicBitArray<Word> &a, const BasicBitArray<Word> &b);
 
 // bitwise multiplication, works only when array sizes match, returns a new object
-BitArray operator&(const BitArray &b1, const BitArray &b2);
+template <typename Word>
+BasicBitArray<Word> operator&(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2);
 // bitwise addition, works only when array sizes match, returns a new object
-BitArray operator|(const BitArray &b1, const BitArray &b2);
+template <typename Word>
+BasicBitArray<Word> operator|(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2);
 // exclusive-or, works only when array sizes match, returns a new object
-BitArray operator^(const BitArray &b1, const BitArray &b2);
\ No newline at end of file
+template <typename Word>
+BasicBitArray<Word> operator^(const BasicBitArray<Word> &b1, const BasicBitArray<Word> &b2);
+
+// sets the n-index bit to val
+template <typename Word>
+inline BasicBitArray<Word> &BasicBitArray<Word>::set(int n, bool val)
+{
+  if ((*this).empty()) // the array empty check
+  {
+    throw std::invalid_argument("Error: array is empty");
+  }
+
+  if (n < 0 || n >= this->length) // the index validitation check
+  {
+    throw std::out_of_range("Error: index is out of range");
+  }
+
+  BITARRAY_RECORD_OP(BitArrayOp::set, 1);
+
+  int counted = (*this).cached_count();
+
+  if (counted >= 0)
+    counted += static_cast<int>(val) - static_cast<int>(((this->array[n / dim] >> (n % dim)) & 1U) != 0U); // the cached count follows the changed bit
+
+  if (val)
+  {
+    this->array[n / dim] |= static_cast<Word>(Word(1) << (n % dim)); // if argument value is true, the word containing the n-index is bitwise added with the bitmask consisting of the true bit shifted to the left
+  }
+  else
+  {
+    this->array[n / dim] &= static_cast<Word>(~(Word(1) << (n % dim))); // if argument value is false, the word containing the n-index is bitwise multiplied with the bitmask consisting of the negated true bit shifted to the left
+  }
+
+  if (this->extras != nullptr) // a plain array has no tracking and no cached count, so its set stays a few instructions
+  {
+    if (this->extras->tracking)
+      (*this).record_change(n, n + 1);
+
+    if (counted >= 0)
+      this->extras->num_true.store(counted, std::memory_order_relaxed); // after record_change, which forgets the count
+  }
+
+  return *this;
+}
+
+// sets the n-index bit to the value false
+template <typename Word>
+inline BasicBitArray<Word> &BasicBitArray<Word>::reset(int n)
+{
+  return (*this).set(n, false); // the n-index cell is set with the value false
+}
+
+// returns the value of the i-index bit
+template <typename Word>
+inline bool BasicBitArray<Word>::operator[](int i) const
+{
+  if ((*this).empty()) // the array empty check
+  {
+    throw std::invalid_argument("Error: array is empty");
+  }
+
+  if (i < 0 || i >= this->length) // the index validitation check
+  {
+    throw std::out_of_range("Error: index is out of range");
+  }
+
+  return ((this->array[i / dim] >> (i % dim)) & 1U) != 0U; // the word containing the i-index is shifted to the right by the bit position, the lowest bit is the i-index bit
+}
+
+// returns the array size
+template <typename Word>
+inline int BasicBitArray<Word>::size() const
+{
+  return this->length;
+}
+
+// returns true if memory for the array is not allocated
+template <typename Word>
+inline bool BasicBitArray<Word>::empty() const
+{
+  return this->array == nullptr; // the allocated memory check
+}
+
+// returns the cached count, -1 if the count is not cached or not known
+template <typename Word>
+inline int BasicBitArray<Word>::cached_count() const
+{
+  return this->extras == nullptr ? -1 : this->extras->num_true.load(std::memory_order_relaxed);
+}
+
+// forgets the cached count, the next count() recounts
+template <typename Word>
+inline void BasicBitArray<Word>::forget_count()
+{
+  if (this->extras != nullptr)
+    this->extras->num_true.store(-1, std::memory_order_relaxed);
+}
+
+// returns a pointer to the words of the array, the n-index bit is the bit n % dim of the word n / dim (LSB-first), the bits after the last bit are false
+template <typename Word>
+inline Word *BasicBitArray<Word>::data()
+{
+  (*this).forget_count(); // the words may be changed through the pointer, so the cached count is recounted
+
+  return this->array;
+}
+
+// returns a pointer to the words of the array, the n-index bit is the bit n % dim of the word n / dim (LSB-first), the bits after the last bit are false
+template <typename Word>
+inline const Word *BasicBitArray<Word>::data() const
+{
+  return this->array;
+}
+
+// creates an object of class BasicBitArray from the bitset, the n-index bit is the bit n of the bitset
+template <typename Word>
+template <std::size_t N>
+BasicBitArray<Word> BasicBitArray<Word>::from_bitset(const std::bitset<N> &b)
+{
+  const int part = dim < 64 ? dim : 64; // the bits taken from the bitset at a time, to_ullong holds at most 64 of them
+  const std::bitset<N> mask(~0ULL >> (64 - part));
+
+  BasicBitArray new_object(static_cast<int>(N));
+  std::bitset<N> rest(b);
+
+  for (int i = 0; i < new_object.capacity / dim; ++i)
+  {
+    Word w = 0;
+
+    for (int j = 0; j < dim; j += part, rest >>= part)
+      w |= static_cast<Word>(static_cast<Word>((rest & mask).to_ullong()) << j); // the bitset is taken a word at a time
+
+    new_object.array[i] = w;
+  }
+
+  return new_object;
+}
+
+// returns the array as a bitset, the bit n of the bitset is the n-index bit, works only when the sizes match
+template <typename Word>
+template <std::size_t N>
+std::bitset<N> BasicBitArray<Word>::to_bitset() const
+{
+  if (static_cast<std::size_t>(this->length) != N) // the sizes check
+  {
+    throw std::runtime_error("Error: array sizes do not match");
+  }
+
+  const int part = dim < 64 ? dim : 64; // the bits put into the bitset at a time
+
+  std::bitset<N> b;
+
+  for (int i = this->capacity / dim - 1; i >= 0; --i)
+  {
+    for (int j = dim - part; j >= 0; j -= part)
+    {
+      b <<= part;
+      b |= std::bitset<N>(static_cast<unsigned long long>(this->array[i] >> j)); // the bitset is filled a word at a time from the highest one
+    }
+  }
+
+  return b;
+}
+
+// returns a uniform random word of type Out built from as many draws of rng as it takes, unbiased when the range of rng is a power of two
+template <typename Word>
+template <typename Out, typename Rng>
+Out BasicBitArray<Word>::random_word(Rng &rng)
+{
+  const int out_bits = static_cast<int>(sizeof(Out) * 8);
+  const unsigned long long range = static_cast<unsigned long long>(Rng::max() - Rng::min());
+  int bits = 0;
+
+  while (bits < 64 && (range >> bits) != 0)
+    ++bits;
+
+  if (bits < 64 && (range & (range + 1)) != 0)
+    --bits; // only the whole low bits of a range that is not a power of two are used
+
+  if (bits >= out_bits)
+    return static_cast<Out>(rng() - Rng::min()); // one draw of a 64-bit generator fills the word
+
+  const unsigned long long mask = bits >= 64 ? ~0ULL : (1ULL << bits) - 1; // a 64-bit draw fills a part of a wider word
+  Out w = 0;
+
+  for (int got = 0; got < out_bits; got += bits)
+    w |= static_cast<Out>(static_cast<Out>(static_cast<unsigned long long>(rng() - Rng::min()) & mask) << got);
+
+  return w;
+}
+
+// fills the array with uniform random bits, a whole word at a time, rng is a UniformRandomBitGenerator such as Xoshiro256
+template <typename Word>
+template <typename Rng>
+BasicBitArray<Word> &BasicBitArray<Word>::fill_random(Rng &rng)
+{
+  if ((*this).empty()) // the array empty check
+  {
+    throw std::invalid_argument("Error: array is empty");
+  }
+
+  BITARRAY_RECORD_OP(BitArrayOp::random, this->capacity / dim);
+
+  for (int i = 0; i < this->capacity / dim; ++i)
+    this->array[i] = random_word<Word>(rng);
+
+  (*this).clear_tail(); // the bits after the last bit of the array stay false
+
+  (*this).record_change(0, this->length);
+
+  return *this;
+}
+
+// fills the array with random bits that are true with probability p, a word at a time from at most 32 uniform words, so p is rounded down to a multiple of 2^-32
+template <typename Word>
+template <typename Rng>
+BasicBitArray<Word> &BasicBitArray<Word>::fill_bernoulli(double p, Rng &rng)
+{
+  if ((*this).empty()) // the array empty check
+  {
+    throw std::invalid_argument("Error: array is empty");
+  }
+
+  if (!(p >= 0.0 && p <= 1.0)) // the argument check, NaN fails it too
+  {
+    throw std::invalid_argument("Error: argument p expects value in [0, 1]");
+  }
+
+  if (p == 1.0)
+    return (*this).set();
+
+  unsigned long long q = static_cast<unsigned long long>(p * 4294967296.0); // the 32 binary digits of p after the point
+
+  if (q == 0)
+    return (*this).reset();
+
+  BITARRAY_RECORD_OP(BitArrayOp::random, this->capacity / dim);
+
+  int lowest = 0;
+
+  while (((q >> lowest) & 1ULL) == 0)
+    ++lowest;
+
+  for (int i = 0; i < this->capacity / dim; ++i)
+  {
+    Word w = random_word<Word>(rng);
+
+    for (int j = lowest + 1; j < 32; ++j) // the digits of p from the lowest one up, a true digit gives 1/2 + P/2 by or, a false one gives P/2 by and
+      w = static_cast<Word>(((q >> j) & 1ULL) ? (w | random_word<Word>(rng)) : (w & random_word<Word>(rng)));
+
+    this->array[i] = w;
+  }
+
+  (*this).clear_tail(); // the bits after the last bit of the array stay false
+
+  (*this).record_change(0, this->length);
+
+  return *this;
+}
+
+// returns the index of a true bit chosen uniformly at random
+template <typename Word>
+template <typename Rng>
+int BasicBitArray<Word>::random_set_bit(Rng &rng) const
+{
+  std::uint32_t n = static_cast<std::uint32_t>((*this).count()); // the count check throws for an empty array
+
+  if (n == 0) // the true bit check
+  {
+    throw std::invalid_argument("Error: array has no true bits");
+  }
+
+  std::uint64_t m = random_word<std::uint32_t>(rng) * static_cast<std::uint64_t>(n); // the rank of the chosen bit is the high half of a 32 x 32-bit product
+
+  if (static_cast<std::uint32_t>(m) < n)
+  {
+    std::uint32_t threshold = (0U - n) % n; // the low halves below the threshold would bias the result and are drawn again
+
+    while (static_cast<std::uint32_t>(m) < threshold)
+      m = random_word<std::uint32_t>(rng) * static_cast<std::uint64_t>(n);
+  }
+
+  return (*this).select(static_cast<int>(m >> 32));
+}
+
+template <typename Word>
+const int BasicBitArray<Word>::dim;
+template <typename Word>
+const int BasicBitArray<Word>::alignment;
+template <typename Word>
+const int BasicBitArray<Word>::change_block_bits;
+template <typename Word>
+const int BasicBitArray<Word>::huge_page_bytes;
+
+// the members that are not inline are compiled once in bitarray.cpp for these word types
+extern template class BasicBitArray<unsigned char>;
+extern template class BasicBitArray<unsigned short>;
+extern template class BasicBitArray<unsigned int>;
+extern template class BasicBitArray<unsigned long>;
+extern template class BasicBitArray<unsigned long long>;
+#if defined(__SIZEOF_INT128__)
+extern template class BasicBitArray<unsigned __int128>;
+#endif
+
+// array of bits stored in unsigned long words, the array used by the rest of the library
+using BitArray = BasicBitArray<unsigned long>;
+
+namespace std
+{
+  // hash function object, lets BasicBitArray be used as a key of unordered containers
+  template <typename Word>
+  struct hash<BasicBitArray<Word>>
+  {
+    std::size_t operator()(const BasicBitArray<Word> &b) const noexcept
+    {
+      return b.hash();
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,289 @@
+#include "bitarray_codec.hpp"
+#include "bitarray_words.hpp"
+
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // number of bits in an unsigned long cell
+    const int word_bits = sizeof(unsigned long) * 8;
+
+    // returns the number of unsigned long cells of the array
+    long long words_of(const BitArray &b)
+    {
+        return (static_cast<long long>(b.size()) + word_bits - 1) / word_bits;
+    }
+
+    // sets the p-index bit of the words
+    void set_bit(unsigned long *words, long long p)
+    {
+        words[p / word_bits] |= 1UL << (p % word_bits);
+    }
+
+    // checks that the array out can take the decoded bits and clears it
+    void prepare_output(int num_bits, BitArray &out)
+    {
+        if (out.size() != num_bits) // the array sizes check
+        {
+            throw std::runtime_error("Error: array sizes do not match");
+        }
+
+        if (!out.empty())
+            out.reset(); // all bits of out are overwritten
+    }
+
+    // throws the error of a malformed encoding
+    [[noreturn]] void malformed()
+    {
+        throw std::invalid_argument("Error: encoding is malformed");
+    }
+
+    // returns the byte length of the gap in the stream-VByte format
+    int gap_length(unsigned long long gap)
+    {
+        return gap < (1ULL << 8) ? 1 : gap < (1ULL << 16) ? 2 : gap < (1ULL << 24) ? 3 : 4;
+    }
+
+#if defined(__SSSE3__)
+    // the shuffle masks moving the bytes of 4 gaps into 4 32-bit lanes and the data lengths of the 4 gaps, indexed by the control byte
+    struct ShuffleTable
+    {
+        alignas(16) unsigned char masks[256][16];
+        unsigned char lengths[256];
+    };
+
+    // builds the shuffle masks once for all control bytes
+    ShuffleTable make_shuffle_table()
+    {
+        ShuffleTable table;
+
+        for (int c = 0; c < 256; ++c)
+        {
+            int offset = 0;
+
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                int length = ((c >> (2 * lane)) & 3) + 1;
+
+                for (int j = 0; j < 4; ++j)
+                    table.masks[c][4 * lane + j] = static_cast<unsigned char>(j < length ? offset + j : 0x80); // 0x80 zeroes the high bytes of a short gap
+
+                offset += length;
+            }
+
+            table.lengths[c] = static_cast<unsigned char>(offset);
+        }
+
+        return table;
+    }
+
+    // returns the shuffle masks, they are built on the first call
+    const ShuffleTable &shuffle_table()
+    {
+        static const ShuffleTable table = make_shuffle_table();
+
+        return table;
+    }
+#endif
+}
+
+// encodes the positions of the true bits of the array in the Elias-Fano format
+EliasFano elias_fano_encode(const BitArray &b)
+{
+    EliasFano e;
+
+    e.num_bits = b.size();
+    e.num_ones = b.empty() ? 0 : b.count();
+
+    if (e.num_ones > 0 && e.num_bits > e.num_ones)
+        e.low_bits = bitarray_words::msb(static_cast<unsigned long long>(e.num_bits / e.num_ones)); // floor(log2(num_bits / num_ones)) balances the low and the high parts
+
+    e.low = BitArray(e.num_ones * e.low_bits);
+    e.high = BitArray(e.num_ones + (e.num_bits >> e.low_bits) + 1);
+
+    unsigned long *low = e.low.data();
+    unsigned long *high = e.high.data();
+    long long k = 0;
+
+    bitarray_words::for_each_one(b.data(), words_of(b), [&](long long p) {
+        if (e.low_bits > 0)
+            bitarray_words::store(low, k * e.low_bits, static_cast<unsigned long>(p), e.low_bits);
+
+        set_bit(high, (p >> e.low_bits) + k); // the high parts are non-decreasing, so adding k makes every bit distinct
+        ++k;
+    });
+
+    return e;
+}
+
+// decodes the Elias-Fano encoding into the array out, works only when out.size() equals the encoded size, all bits of out are overwritten
+void elias_fano_decode(const EliasFano &e, BitArray &out)
+{
+    if (e.num_bits < 0 || e.num_ones < 0 || e.low_bits < 0 || e.low_bits >= word_bits || e.low.size() != e.num_ones * e.low_bits ||
+        e.high.size() != e.num_ones + (e.num_bits >> e.low_bits) + 1) // the encoding validitation check
+    {
+        malformed();
+    }
+
+    prepare_output(e.num_bits, out);
+
+    unsigned long *words = out.data();
+    const unsigned long *low = e.low.data();
+    const long long low_end = static_cast<long long>(e.num_ones) * e.low_bits;
+    const unsigned long low_mask = bitarray_words::low_mask<unsigned long>(e.low_bits);
+    long long k = 0;
+
+    bitarray_words::for_each_one(e.high.data(), words_of(e.high), [&](long long q) {
+        if (k == e.num_ones) // more high bits than positions
+            malformed();
+
+        long long p = (q - k) << e.low_bits;
+
+        if (e.low_bits > 0)
+            p |= static_cast<long long>(bitarray_words::load(low, k * e.low_bits, low_end) & low_mask); // the low bits are read with one unaligned word load
+
+        if (p >= e.num_bits) // the position validitation check
+            malformed();
+
+        set_bit(words, p);
+        ++k;
+    });
+
+    if (k != e.num_ones) // fewer high bits than positions
+        malformed();
+}
+
+// decodes the Elias-Fano encoding into a new object of class BitArray
+BitArray elias_fano_decode(const EliasFano &e)
+{
+    if (e.num_bits < 0) // the encoding validitation check
+        malformed();
+
+    BitArray new_object(e.num_bits);
+
+    elias_fano_decode(e, new_object);
+
+    return new_object;
+}
+
+// encodes the gaps between the true bits of the array in the stream-VByte format
+VByteList vbyte_encode(const BitArray &b)
+{
+    VByteList list;
+
+    list.num_bits = b.size();
+    list.num_ones = b.empty() ? 0 : b.count();
+    list.control.assign((list.num_ones + 3) / 4, 0);
+    list.data.reserve(list.num_ones); // most gaps of a dense enough array take one byte
+
+    long long prev = -1;
+    long long k = 0;
+
+    bitarray_words::for_each_one(b.data(), words_of(b), [&](long long p) {
+        unsigned long long gap = static_cast<unsigned long long>(p - prev - 1);
+        int length = gap_length(gap);
+
+        list.control[k / 4] |= static_cast<unsigned char>((length - 1) << (2 * (k % 4)));
+
+        for (int j = 0; j < length; ++j)
+            list.data.push_back(static_cast<unsigned char>(gap >> (8 * j)));
+
+        prev = p;
+        ++k;
+    });
+
+    return list;
+}
+
+// decodes the stream-VByte encoding into the array out, works only when out.size() equals the encoded size, all bits of out are overwritten
+void vbyte_decode(const VByteList &list, BitArray &out)
+{
+    if (list.num_bits < 0 || list.num_ones < 0 || list.control.size() != static_cast<std::size_t>(list.num_ones + 3) / 4) // the encoding validitation check
+    {
+        malformed();
+    }
+
+    prepare_output(list.num_bits, out);
+
+    unsigned long *words = out.data();
+    const unsigned char *data = list.data.data();
+    const std::size_t size = list.data.size();
+    std::size_t pos = 0;
+    long long prev = -1;
+    int k = 0;
+
+#if defined(__SSSE3__)
+    const ShuffleTable &table = shuffle_table();
+    const __m128i ones = _mm_set1_epi32(1);
+    const __m128i large = _mm_set1_epi32(static_cast<int>(0xF0000000U));
+
+    for (; k + 4 <= list.num_ones && pos + 16 <= size; k += 4) // a full group of 4 gaps with 16 readable data bytes
+    {
+        unsigned char c = list.control[k / 4];
+        __m128i gaps = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos)), _mm_load_si128(reinterpret_cast<const __m128i *>(table.masks[c])));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(gaps, large), _mm_setzero_si128())) != 0xFFFF)
+            break; // gaps of 2^28 or more could overflow the 32-bit lanes and are left to the scalar loop
+
+        __m128i v = _mm_add_epi32(gaps, ones);
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4)); // the prefix sum of the 4 lanes in two steps
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, _mm_set1_epi32(static_cast<int>(prev)));
+
+        alignas(16) std::uint32_t positions[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(positions), v);
+
+        if (positions[3] >= static_cast<std::uint32_t>(list.num_bits)) // the positions increase, so checking the last one checks all four
+            malformed();
+
+        set_bit(words, positions[0]);
+        set_bit(words, positions[1]);
+        set_bit(words, positions[2]);
+        set_bit(words, positions[3]);
+
+        prev = positions[3];
+        pos += table.lengths[c];
+    }
+#endif
+
+    for (; k < list.num_ones; ++k)
+    {
+        int length = ((list.control[k / 4] >> (2 * (k % 4))) & 3) + 1;
+
+        if (pos + length > size) // the data size check
+            malformed();
+
+        unsigned long long gap = 0;
+
+        for (int j = 0; j < length; ++j)
+            gap |= static_cast<unsigned long long>(data[pos + j]) << (8 * j);
+
+        pos += length;
+
+        long long p = prev + 1 + static_cast<long long>(gap);
+
+        if (p >= list.num_bits) // the position validitation check
+            malformed();
+
+        set_bit(words, p);
+        prev = p;
+    }
+
+    if (pos != size) // the data size check
+        malformed();
+}
+
+// decodes the stream-VByte encoding into a new object of class BitArray
+BitArray vbyte_decode(const VByteList &list)
+{
+    if (list.num_bits < 0) // the encoding validitation check
+        malformed();
+
+    BitArray new_object(list.num_bits);
+
+    vbyte_decode(list, new_object);
+
+    return new_object;
+}
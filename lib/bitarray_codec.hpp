@@ -0,0 +1,39 @@
+#ifndef BITARRAY_CODEC_HPP
+#define BITARRAY_CODEC_HPP
+
+#include "bitarray.hpp"
+
+// Elias-Fano encoding of the positions of the true bits of a BitArray, takes at most 3 + log2(num_bits / num_ones) bits per true bit
+struct EliasFano
+{
+  int num_bits{0}; // the size of the encoded array
+  int num_ones{0}; // the number of true bits
+  int low_bits{0}; // the number of low bits of a position stored verbatim
+  BitArray low;    // the low bits of the positions, low_bits bits per position
+  BitArray high;   // the high parts of the positions in unary, the k-index position sets the bit (position >> low_bits) + k
+};
+
+// stream-VByte encoding of the gaps between the true bits of a BitArray, the gap before a position is position - previous position - 1
+struct VByteList
+{
+  int num_bits{0};                     // the size of the encoded array
+  int num_ones{0};                     // the number of true bits
+  std::vector<unsigned char> control;  // 2 bits per gap, the byte length of the gap - 1, 4 gaps per byte
+  std::vector<unsigned char> data;     // the gaps as 1 to 4 little-endian bytes each, stored apart from the control bytes so that a group of 4 gaps is decoded with one shuffle
+};
+
+// encodes the positions of the true bits of the array in the Elias-Fano format
+EliasFano elias_fano_encode(const BitArray &b);
+// decodes the Elias-Fano encoding into the array out, works only when out.size() equals the encoded size, all bits of out are overwritten
+void elias_fano_decode(const EliasFano &e, BitArray &out);
+// decodes the Elias-Fano encoding into a new object of class BitArray
+BitArray elias_fano_decode(const EliasFano &e);
+
+// encodes the gaps between the true bits of the array in the stream-VByte format
+VByteList vbyte_encode(const BitArray &b);
+// decodes the stream-VByte encoding into the array out, works only when out.size() equals the encoded size, all bits of out are overwritten
+void vbyte_decode(const VByteList &list, BitArray &out);
+// decodes the stream-VByte encoding into a new object of class BitArray
+BitArray vbyte_decode(const VByteList &list);
+
+#endif
@@ -0,0 +1,305 @@
+#include "bitarray_pool.hpp"
+#include "bitarray_words.hpp"
+
+#include <cstring>
+#include <new>
+
+const int BitArrayPool::dim;
+
+// frees a slab allocated by allocate
+void BitArrayPool::SlabDeleter::operator()(unsigned long *words) const
+{
+    ::operator delete[](words, std::align_val_t(BitArray::alignment));
+}
+
+// allocates a zero-filled slab of words aligned to a cache line
+unsigned long *BitArrayPool::allocate(std::size_t words)
+{
+    void *memory = ::operator new[](words * sizeof(unsigned long), std::align_val_t(BitArray::alignment)); // the slab is aligned like the arrays of BitArray
+
+    std::memset(memory, 0, words * sizeof(unsigned long));
+
+    return static_cast<unsigned long *>(memory);
+}
+
+// returns the pointer to the words of the k-index member
+unsigned long *BitArrayPool::member_words(int k)
+{
+    return this->slab.get() + static_cast<std::size_t>(k) * this->stride;
+}
+
+// returns the pointer to the words of the k-index member
+const unsigned long *BitArrayPool::member_words(int k) const
+{
+    return this->slab.get() + static_cast<std::size_t>(k) * this->stride;
+}
+
+// returns the words of the view b as a zero-padded array of stride words, works only when b.size() matches the member length
+std::vector<unsigned long> BitArrayPool::load_mask(const BitArrayView &b) const
+{
+    if (b.size() != this->num_bits) // the sizes check
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    std::vector<unsigned long> words(this->stride, 0UL);
+
+    if (!b.empty())
+        bitarray_words::copy(words.data(), 0, b.data(), b.bit_offset(), b.size()); // the view may start inside a word and end before the last word of its array
+
+    return words;
+}
+
+// default constructor, creates an empty pool of empty members
+BitArrayPool::BitArrayPool() {}
+
+// creates a pool of num_members false members of num_bits bits each
+BitArrayPool::BitArrayPool(int num_bits, int num_members) : num_bits(num_bits)
+{
+    if (num_bits < 0 || num_members < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: arguments num_bits and num_members expect values >= 0");
+    }
+
+    this->stride = static_cast<int>((static_cast<long long>(num_bits) + dim - 1) / dim); // rounded up in long long, a length near INT_MAX overflows int
+
+    (*this).reserve(num_members);
+
+    this->num_members = num_members;
+}
+
+// copy constructor, creates a pool by copying the slab of pool b
+BitArrayPool::BitArrayPool(const BitArrayPool &b) : num_bits(b.num_bits), stride(b.stride)
+{
+    (*this).reserve(b.num_members);
+
+    if (b.num_members > 0)
+        std::copy(b.member_words(0), b.member_words(b.num_members), this->slab.get());
+
+    this->num_members = b.num_members;
+}
+
+// move constructor, creates a pool by taking the slab of pool b, b is left with no members of the same length
+BitArrayPool::BitArrayPool(BitArrayPool &&b) noexcept : slab(std::move(b.slab)), num_bits(b.num_bits), stride(b.stride), num_members(b.num_members), capacity(b.capacity)
+{
+    b.num_members = 0; // b has no slab now, so it has no members and no room
+    b.capacity = 0;
+}
+
+// assignment operator, assigns the members of one pool to another pool
+BitArrayPool &BitArrayPool::operator=(const BitArrayPool &b)
+{
+    if (this != &b)
+    {
+        BitArrayPool copy(b);
+
+        std::swap(this->slab, copy.slab);
+        std::swap(this->num_bits, copy.num_bits);
+        std::swap(this->stride, copy.stride);
+        std::swap(this->num_members, copy.num_members);
+        std::swap(this->capacity, copy.capacity);
+    }
+
+    return *this;
+}
+
+// move assignment operator, frees the slab and takes the slab of pool b, b is left with no members of the same length
+BitArrayPool &BitArrayPool::operator=(BitArrayPool &&b) noexcept
+{
+    if (this != &b)
+    {
+        this->slab = std::move(b.slab); // the old slab is freed
+        this->num_bits = b.num_bits;
+        this->stride = b.stride;
+        this->num_members = b.num_members;
+        this->capacity = b.capacity;
+        b.num_members = 0;
+        b.capacity = 0;
+    }
+
+    return *this;
+}
+
+// returns the number of members
+int BitArrayPool::size() const
+{
+    return this->num_members;
+}
+
+// returns the length of every member
+int BitArrayPool::bits() const
+{
+    return this->num_bits;
+}
+
+// returns true if the pool has no members
+bool BitArrayPool::empty() const
+{
+    return this->num_members == 0;
+}
+
+// makes room for num_members members without reallocation, the views stay valid until the pool grows past its capacity
+void BitArrayPool::reserve(int num_members)
+{
+    if (num_members < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument num_members expects value >= 0");
+    }
+
+    if (num_members <= this->capacity)
+        return;
+
+    std::unique_ptr<unsigned long[], SlabDeleter> new_slab(allocate(static_cast<std::size_t>(num_members) * this->stride));
+
+    if (this->num_members > 0)
+        std::copy((*this).member_words(0), (*this).member_words(this->num_members), new_slab.get()); // the members are moved with one copy of the slab
+
+    this->slab = std::move(new_slab);
+    this->capacity = num_members;
+}
+
+// adds a false member to the end of the pool, returns its index
+int BitArrayPool::push_back()
+{
+    if (this->num_members == this->capacity)
+        (*this).reserve(std::max(16, this->capacity + this->capacity / 2)); // the slab grows geometrically, so adding a member costs amortised O(stride)
+
+    std::fill((*this).member_words(this->num_members), (*this).member_words(this->num_members + 1), 0UL); // a slot left by clear may hold old bits
+
+    return this->num_members++;
+}
+
+// adds a copy of b to the end of the pool, works only when b.size() matches the member length, returns its index
+int BitArrayPool::push_back(const BitArrayView &b)
+{
+    std::vector<unsigned long> words = (*this).load_mask(b); // the view is read before the slab may move, so b may view a member of this pool
+
+    int k = (*this).push_back();
+
+    std::copy(words.begin(), words.end(), (*this).member_words(k));
+
+    return k;
+}
+
+// removes all members, keeps the slab
+void BitArrayPool::clear()
+{
+    this->num_members = 0;
+}
+
+// returns a mutable span of the k-index member, it stays valid until the pool grows past its capacity
+BitArraySpan BitArrayPool::operator[](int k)
+{
+    if (k < 0 || k >= this->num_members) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    return BitArraySpan((*this).member_words(k), 0, this->num_bits);
+}
+
+// returns a read-only view of the k-index member, it stays valid until the pool grows past its capacity
+BitArrayView BitArrayPool::operator[](int k) const
+{
+    if (k < 0 || k >= this->num_members) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    return BitArrayView((*this).member_words(k), 0, this->num_bits);
+}
+
+// writes the number of true bits of every member to out, size() counts
+void BitArrayPool::count_all(int *out) const
+{
+    const unsigned long *words = this->slab.get();
+
+    for (int k = 0; k < this->num_members; ++k, words += this->stride) // the slab is read once from the beginning to the end
+    {
+        int count = 0;
+
+        for (int i = 0; i < this->stride; ++i)
+            count += bitarray_words::popcount(words[i]);
+
+        out[k] = count;
+    }
+}
+
+// returns the number of true bits of every member
+std::vector<int> BitArrayPool::count_all() const
+{
+    std::vector<int> counts(this->num_members);
+
+    (*this).count_all(counts.data());
+
+    return counts;
+}
+
+// writes the number of true bits of every member AND mask to out without changing the members, size() counts, works only when mask.size() matches the member length
+void BitArrayPool::count_and(const BitArrayView &mask, int *out) const
+{
+    std::vector<unsigned long> m = (*this).load_mask(mask);
+    const unsigned long *words = this->slab.get();
+
+    for (int k = 0; k < this->num_members; ++k, words += this->stride) // the mask stays in the cache while the slab streams by
+    {
+        int count = 0;
+
+        for (int i = 0; i < this->stride; ++i)
+            count += bitarray_words::popcount(words[i] & m[i]);
+
+        out[k] = count;
+    }
+}
+
+// returns the number of true bits of every member AND mask without changing the members, works only when mask.size() matches the member length
+std::vector<int> BitArrayPool::count_and(const BitArrayView &mask) const
+{
+    std::vector<int> counts(this->num_members);
+
+    (*this).count_and(mask, counts.data());
+
+    return counts;
+}
+
+// bitwise multiplication of every member with mask, works only when mask.size() matches the member length
+BitArrayPool &BitArrayPool::and_all(const BitArrayView &mask)
+{
+    std::vector<unsigned long> m = (*this).load_mask(mask); // the mask is copied first, so it may view a member of this pool
+    unsigned long *words = this->slab.get();
+
+    for (int k = 0; k < this->num_members; ++k, words += this->stride)
+    {
+        for (int i = 0; i < this->stride; ++i)
+            words[i] &= m[i];
+    }
+
+    return *this;
+}
+
+// bitwise addition of every member with mask, works only when mask.size() matches the member length
+BitArrayPool &BitArrayPool::or_all(const BitArrayView &mask)
+{
+    std::vector<unsigned long> m = (*this).load_mask(mask); // the mask is copied first, so it may view a member of this pool, its bits after the member length are false
+    unsigned long *words = this->slab.get();
+
+    for (int k = 0; k < this->num_members; ++k, words += this->stride)
+    {
+        for (int i = 0; i < this->stride; ++i)
+            words[i] |= m[i];
+    }
+
+    return *this;
+}
+
+// returns the pointer to the slab, the k-index member is the words [k * words_per_member(), (k + 1) * words_per_member())
+const unsigned long *BitArrayPool::data() const
+{
+    return this->slab.get();
+}
+
+// returns the number of words per member
+int BitArrayPool::words_per_member() const
+{
+    return this->stride;
+}
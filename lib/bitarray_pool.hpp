@@ -0,0 +1,91 @@
+#ifndef BITARRAY_POOL_HPP
+#define BITARRAY_POOL_HPP
+
+#include "bitarray.hpp"
+#include "bitarray_view.hpp"
+
+// pool of equal-length bitsets stored back to back in one slab aligned to a cache line, every member starts at a word boundary, so a batch operation over all members is one streaming pass over the slab
+class BitArrayPool
+{
+private:
+  // frees a slab allocated by allocate
+  struct SlabDeleter
+  {
+    void operator()(unsigned long *words) const;
+  };
+
+  std::unique_ptr<unsigned long[], SlabDeleter> slab;
+  int num_bits{0};     // the length of every member
+  int stride{0};       // the number of words per member
+  int num_members{0};
+  int capacity{0};     // the number of members the slab can hold
+
+  // allocates a zero-filled slab of words aligned to a cache line
+  static unsigned long *allocate(std::size_t words);
+
+  // returns the pointer to the words of the k-index member
+  unsigned long *member_words(int k);
+  // returns the pointer to the words of the k-index member
+  const unsigned long *member_words(int k) const;
+
+  // returns the words of the view b as a zero-padded array of stride words, works only when b.size() matches the member length
+  std::vector<unsigned long> load_mask(const BitArrayView &b) const;
+
+public:
+  static const int dim{sizeof(unsigned long) * 8};
+
+  // default constructor, creates an empty pool of empty members
+  BitArrayPool();
+  // creates a pool of num_members false members of num_bits bits each
+  explicit BitArrayPool(int num_bits, int num_members = 0);
+  // copy constructor, creates a pool by copying the slab of pool b
+  BitArrayPool(const BitArrayPool &b);
+  // move constructor, creates a pool by taking the slab of pool b, b is left with no members of the same length
+  BitArrayPool(BitArrayPool &&b) noexcept;
+  // assignment operator, assigns the members of one pool to another pool
+  BitArrayPool &operator=(const BitArrayPool &b);
+  // move assignment operator, frees the slab and takes the slab of pool b, b is left with no members of the same length
+  BitArrayPool &operator=(BitArrayPool &&b) noexcept;
+
+  // returns the number of members
+  int size() const;
+  // returns the length of every member
+  int bits() const;
+  // returns true if the pool has no members
+  bool empty() const;
+
+  // makes room for num_members members without reallocation, the views stay valid until the pool grows past its capacity
+  void reserve(int num_members);
+  // adds a false member to the end of the pool, returns its index
+  int push_back();
+  // adds a copy of b to the end of the pool, works only when b.size() matches the member length, returns its index
+  int push_back(const BitArrayView &b);
+  // removes all members, keeps the slab
+  void clear();
+
+  // returns a mutable span of the k-index member, it stays valid until the pool grows past its capacity
+  BitArraySpan operator[](int k);
+  // returns a read-only view of the k-index member, it stays valid until the pool grows past its capacity
+  BitArrayView operator[](int k) const;
+
+  // writes the number of true bits of every member to out, size() counts
+  void count_all(int *out) const;
+  // returns the number of true bits of every member
+  std::vector<int> count_all() const;
+  // writes the number of true bits of every member AND mask to out without changing the members, size() counts, works only when mask.size() matches the member length
+  void count_and(const BitArrayView &mask, int *out) const;
+  // returns the number of true bits of every member AND mask without changing the members, works only when mask.size() matches the member length
+  std::vector<int> count_and(const BitArrayView &mask) const;
+
+  // bitwise multiplication of every member with mask, works only when mask.size() matches the member length
+  BitArrayPool &and_all(const BitArrayView &mask);
+  // bitwise addition of every member with mask, works only when mask.size() matches the member length
+  BitArrayPool &or_all(const BitArrayView &mask);
+
+  // returns the pointer to the slab, the k-index member is the words [k * words_per_member(), (k + 1) * words_per_member())
+  const unsigned long *data() const;
+  // returns the number of words per member
+  int words_per_member() const;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef BITARRAY_RANDOM_HPP
+#define BITARRAY_RANDOM_HPP
+
+#include <cstdint>
+
+// xoshiro256** generator of 64-bit words, a UniformRandomBitGenerator fast enough to feed BitArray::fill_random and fill_bernoulli a whole word per call
+class Xoshiro256
+{
+private:
+  std::uint64_t s[4];
+
+  // rotates the word to the left by k, 0 < k < 64
+  static std::uint64_t rotl(std::uint64_t x, int k)
+  {
+    return (x << k) | (x >> (64 - k));
+  }
+
+public:
+  using result_type = std::uint64_t;
+
+  // creates a generator whose state is expanded from the seed by splitmix64, so that close seeds give unrelated sequences
+  explicit Xoshiro256(std::uint64_t seed = 0)
+  {
+    for (int i = 0; i < 4; ++i)
+    {
+      seed += 0x9E3779B97F4A7C15ULL; // splitmix64 step
+      std::uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      this->s[i] = z ^ (z >> 31);
+    }
+  }
+
+  // returns the smallest generated value
+  static constexpr result_type min()
+  {
+    return 0;
+  }
+
+  // returns the largest generated value
+  static constexpr result_type max()
+  {
+    return ~result_type(0);
+  }
+
+  // returns the next uniform 64-bit word
+  result_type operator()()
+  {
+    const std::uint64_t result = rotl(this->s[1] * 5, 7) * 9;
+    const std::uint64_t t = this->s[1] << 17;
+
+    this->s[2] ^= this->s[0];
+    this->s[3] ^= this->s[1];
+    this->s[1] ^= this->s[2];
+    this->s[0] ^= this->s[3];
+    this->s[2] ^= t;
+    this->s[3] = rotl(this->s[3], 45);
+
+    return result;
+  }
+};
+
+#endif
@@ -0,0 +1,352 @@
+#include "bitarray_snapshot.hpp"
+#include "bitarray_words.hpp"
+
+#include <cstring>
+#include <new>
+
+const int BitArraySnapshot::dim;
+const int SharedBitArray::dim;
+const int SharedBitArray::default_block_bits;
+
+namespace
+{
+    // frees a block allocated by SharedBitArray::allocate_block
+    struct BlockDeleter
+    {
+        void operator()(unsigned long *words) const
+        {
+            ::operator delete[](words, std::align_val_t(BitArray::alignment));
+        }
+    };
+}
+
+// creates a snapshot of the version
+BitArraySnapshot::BitArraySnapshot(std::shared_ptr<const Version> version) : version(std::move(version)) {}
+
+// default constructor, creates an empty snapshot
+BitArraySnapshot::BitArraySnapshot() {}
+
+// returns the number of publishes before this version, a later snapshot never has a lower one
+std::uint64_t BitArraySnapshot::version_number() const
+{
+    return this->version == nullptr ? 0 : this->version->number;
+}
+
+// counts the number of true bits
+int BitArraySnapshot::count() const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    int count = 0;
+
+    for (int k = 0; k < (*this).num_blocks(); ++k)
+        count += (*this).block(k).count();
+
+    return count;
+}
+
+// return true if the snapshot contains one or more true bits
+bool BitArraySnapshot::any() const
+{
+    if ((*this).empty()) // the array empty check
+    {
+        throw std::invalid_argument("Error: array is empty");
+    }
+
+    for (int k = 0; k < (*this).num_blocks(); ++k)
+    {
+        if ((*this).block(k).any())
+            return true;
+    }
+
+    return false;
+}
+
+// returns the number of bits in a block
+int BitArraySnapshot::block_bits() const
+{
+    return this->version == nullptr ? 0 : this->version->block_bits;
+}
+
+// returns the number of blocks
+int BitArraySnapshot::num_blocks() const
+{
+    return this->version == nullptr ? 0 : static_cast<int>(this->version->blocks.size());
+}
+
+// returns a view of the k-index block, the last block may be shorter, the view stays valid while the snapshot is held
+BitArrayView BitArraySnapshot::block(int k) const
+{
+    if (k < 0 || k >= (*this).num_blocks()) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    const int block_bits = this->version->block_bits;
+
+    return BitArrayView(this->version->blocks[k].get(), 0, std::min(block_bits, this->version->num_bits - k * block_bits));
+}
+
+// copies the bits of the snapshot to a new object of class BitArray
+BitArray BitArraySnapshot::to_bitarray() const
+{
+    BitArray new_object((*this).size());
+
+    for (int k = 0; k < (*this).num_blocks(); ++k)
+    {
+        BitArrayView b = (*this).block(k);
+
+        std::copy(b.data(), b.data() + (b.size() + dim - 1) / dim, new_object.data() + static_cast<std::size_t>(k) * (this->version->block_bits / dim)); // the blocks are whole words, so they are copied word by word
+    }
+
+    return new_object;
+}
+
+// returns the number of words of the k-index block, the last block holds only the words up to the last bit
+int SharedBitArray::block_words(int k) const
+{
+    return (std::min(this->bits_per_block, this->num_bits - k * this->bits_per_block) + dim - 1) / dim;
+}
+
+// allocates the k-index block aligned to a cache line, filled with the words at src or with false if src is nullptr
+std::shared_ptr<unsigned long> SharedBitArray::allocate_block(int k, const unsigned long *src) const
+{
+    const int words = (*this).block_words(k);
+    unsigned long *memory = static_cast<unsigned long *>(::operator new[](words * sizeof(unsigned long), std::align_val_t(BitArray::alignment)));
+
+    if (src != nullptr)
+        std::memcpy(memory, src, words * sizeof(unsigned long));
+    else
+        std::memset(memory, 0, words * sizeof(unsigned long));
+
+    return std::shared_ptr<unsigned long>(memory, BlockDeleter());
+}
+
+// returns the words of the k-index block of the draft, copies the block first if it is shared with a published version
+unsigned long *SharedBitArray::write_block(int k)
+{
+    if (this->writable[k] == nullptr)
+    {
+        std::shared_ptr<unsigned long> copy = (*this).allocate_block(k, this->draft[k].get()); // the readers of the published versions keep the old block
+
+        this->writable[k] = copy.get();
+        this->draft[k] = std::move(copy);
+        ++this->num_copied;
+    }
+
+    return this->writable[k];
+}
+
+// creates an array of num_bits false bits in blocks of block_bits bits, works only when block_bits is a power of two and a multiple of dim, the initial version is published
+SharedBitArray::SharedBitArray(int num_bits, int block_bits) : num_bits(num_bits), bits_per_block(block_bits)
+{
+    if (num_bits < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument num_bits expects value >= 0");
+    }
+
+    if (block_bits < dim || (block_bits & (block_bits - 1)) != 0) // the argument check, a power of two of at least dim bits is a multiple of dim
+    {
+        throw std::invalid_argument("Error: argument block_bits expects a power of two >= the word size");
+    }
+
+    while ((1 << this->block_shift) < block_bits)
+        ++this->block_shift;
+
+    const int blocks = static_cast<int>((static_cast<long long>(num_bits) + block_bits - 1) / block_bits);
+
+    this->draft.reserve(blocks);
+    this->writable.assign(blocks, nullptr);
+
+    for (int k = 0; k < blocks; ++k)
+        this->draft.push_back((*this).allocate_block(k, nullptr));
+
+    std::shared_ptr<BitArraySnapshot::Version> version = std::make_shared<BitArraySnapshot::Version>();
+    version->blocks = this->draft;
+    version->num_bits = num_bits;
+    version->block_bits = block_bits;
+    version->block_shift = this->block_shift;
+
+    std::atomic_store(&this->published, std::shared_ptr<const BitArraySnapshot::Version>(std::move(version)));
+}
+
+// creates an array with the bits of b in blocks of block_bits bits, works only when block_bits is a power of two and a multiple of dim, the initial version is published
+SharedBitArray::SharedBitArray(const BitArray &b, int block_bits) : SharedBitArray(b.size(), block_bits)
+{
+    if (!b.empty())
+    {
+        (*this).assign(b);
+        (*this).publish();
+    }
+}
+
+// returns the latest published version, safe to call from any thread at any time
+BitArraySnapshot SharedBitArray::snapshot() const
+{
+    return BitArraySnapshot(std::atomic_load(&this->published)); // the load and the store of publish are atomic, so a reader sees the old or the new version whole
+}
+
+// returns the array size
+int SharedBitArray::size() const
+{
+    return this->num_bits;
+}
+
+// returns the number of bits in a block
+int SharedBitArray::block_bits() const
+{
+    return this->bits_per_block;
+}
+
+// returns the number of blocks copied since the last publish
+int SharedBitArray::pending_blocks() const
+{
+    return this->num_copied;
+}
+
+// returns the value of the i-index bit in the draft of the next version
+bool SharedBitArray::test(int i) const
+{
+    if (i < 0 || i >= this->num_bits) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    const unsigned long *words = this->draft[i >> this->block_shift].get();
+
+    return ((words[(i & (this->bits_per_block - 1)) / dim] >> (i % dim)) & 1UL) != 0UL;
+}
+
+// sets the n-index bit of the draft to val, copies its block once per publish
+SharedBitArray &SharedBitArray::set(int n, bool val)
+{
+    if (n < 0 || n >= this->num_bits) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    if ((*this).test(n) == val)
+        return *this; // an unchanged bit does not copy its block
+
+    unsigned long *words = (*this).write_block(n >> this->block_shift);
+
+    words[(n & (this->bits_per_block - 1)) / dim] ^= 1UL << (n % dim);
+
+    return *this;
+}
+
+// sets the n-index bit of the draft to the value false
+SharedBitArray &SharedBitArray::reset(int n)
+{
+    return (*this).set(n, false);
+}
+
+// makes the draft equal to b, copies only the blocks whose bits differ, works only when array sizes match
+SharedBitArray &SharedBitArray::assign(const BitArray &b)
+{
+    if (b.size() != this->num_bits) // the sizes check
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    const int stride = this->bits_per_block / dim;
+
+    for (int k = 0; k < static_cast<int>(this->draft.size()); ++k)
+    {
+        const unsigned long *src = b.data() + static_cast<std::size_t>(k) * stride;
+        const int words = (*this).block_words(k);
+
+        if (std::memcmp(this->draft[k].get(), src, words * sizeof(unsigned long)) != 0) // the equal blocks stay shared
+            std::memcpy((*this).write_block(k), src, words * sizeof(unsigned long));
+    }
+
+    return *this;
+}
+
+// writes the changes of the delta to the draft, copies only the blocks of the changed ranges, works only when the delta source has the array size
+SharedBitArray &SharedBitArray::apply_delta(const BitArrayDelta &delta)
+{
+    const int total = (delta.num_bits + 63) / 64;
+    std::size_t num_words = 0;
+
+    if (delta.num_bits < 0 || delta.ranges.size() % 2 != 0) // the delta validitation check
+    {
+        throw std::invalid_argument("Error: delta is malformed");
+    }
+
+    for (std::size_t r = 0; r < delta.ranges.size(); r += 2)
+    {
+        int first = delta.ranges[r];
+        int last = delta.ranges[r + 1];
+
+        if (first < (r == 0 ? 0 : delta.ranges[r - 1]) || first >= last || last > total) // the ranges must be ascending and inside the array
+        {
+            throw std::invalid_argument("Error: delta is malformed");
+        }
+
+        num_words += last - first;
+    }
+
+    if (num_words != delta.words.size()) // the payload size check
+    {
+        throw std::invalid_argument("Error: delta is malformed");
+    }
+
+    if (delta.num_bits != this->num_bits) // the sizes check, the blocks of a shared array are never resized
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    const std::uint64_t *w = delta.words.data();
+
+    for (std::size_t r = 0; r < delta.ranges.size(); r += 2)
+    {
+        for (int k = delta.ranges[r]; k < delta.ranges[r + 1]; ++k, ++w)
+        {
+            for (int part = 0; part < 64 && k * 64LL + part < this->num_bits; part += dim) // a 64-bit word is one unsigned long cell or two, each inside one block
+            {
+                const int pos = k * 64 + part;
+                const int len = std::min(dim, this->num_bits - pos);
+
+                (*this).write_block(pos / this->bits_per_block)[pos % this->bits_per_block / dim] = static_cast<unsigned long>(*w >> part) & bitarray_words::low_mask<unsigned long>(len); // the payload bits after the last bit are ignored
+            }
+        }
+    }
+
+    return *this;
+}
+
+// forgets the changes since the last publish
+void SharedBitArray::discard()
+{
+    if (this->num_copied == 0)
+        return;
+
+    this->draft = this->published->blocks; // only the writer stores the published version, so it reads it without the atomic load
+    std::fill(this->writable.begin(), this->writable.end(), nullptr);
+    this->num_copied = 0;
+}
+
+// makes the draft the latest version with one atomic store, the blocks of the earlier versions are freed when their last snapshot is released, returns the version number
+std::uint64_t SharedBitArray::publish()
+{
+    if (this->num_copied == 0)
+        return this->published->number; // nothing changed, the readers keep the current version
+
+    std::shared_ptr<BitArraySnapshot::Version> version = std::make_shared<BitArraySnapshot::Version>();
+    version->blocks = this->draft; // one pointer copy per block, the unchanged blocks are shared with the published version
+    version->num_bits = this->num_bits;
+    version->block_bits = this->bits_per_block;
+    version->block_shift = this->block_shift;
+    version->number = this->published->number + 1;
+
+    std::atomic_store(&this->published, std::shared_ptr<const BitArraySnapshot::Version>(std::move(version)));
+
+    std::fill(this->writable.begin(), this->writable.end(), nullptr); // the copied blocks are shared with the readers now, the next change copies them again
+    this->num_copied = 0;
+
+    return this->published->number;
+}
@@ -0,0 +1,149 @@
+#ifndef BITARRAY_SNAPSHOT_HPP
+#define BITARRAY_SNAPSHOT_HPP
+
+#include "bitarray.hpp"
+#include "bitarray_view.hpp"
+
+// immutable version of a SharedBitArray, taking it copies one pointer, its bits never change while it is held, so it may be read without locks by any number of threads
+class BitArraySnapshot
+{
+  friend class SharedBitArray;
+
+private:
+  // a published version, the bits [k * block_bits, (k + 1) * block_bits) are the block k, the blocks not changed between versions are shared by them
+  struct Version
+  {
+    std::vector<std::shared_ptr<const unsigned long>> blocks;
+    int num_bits{0};
+    int block_bits{0};
+    int block_shift{0};      // block_bits = 1 << block_shift, so the block of a bit is found by a shift
+    std::uint64_t number{0}; // the number of publishes before this version
+  };
+
+  std::shared_ptr<const Version> version;
+
+  // creates a snapshot of the version
+  explicit BitArraySnapshot(std::shared_ptr<const Version> version);
+
+public:
+  static const int dim{sizeof(unsigned long) * 8};
+
+  // default constructor, creates an empty snapshot
+  BitArraySnapshot();
+
+  // returns the array size
+  int size() const;
+  // returns true if the snapshot has no bits
+  bool empty() const;
+  // returns the number of publishes before this version, a later snapshot never has a lower one
+  std::uint64_t version_number() const;
+
+  // returns the value of the i-index bit
+  bool operator[](int i) const;
+  // counts the number of true bits
+  int count() const;
+  // return true if the snapshot contains one or more true bits
+  bool any() const;
+
+  // returns the number of bits in a block
+  int block_bits() const;
+  // returns the number of blocks
+  int num_blocks() const;
+  // returns a view of the k-index block, the last block may be shorter, the view stays valid while the snapshot is held
+  BitArrayView block(int k) const;
+
+  // copies the bits of the snapshot to a new object of class BitArray
+  BitArray to_bitarray() const;
+};
+
+// array of bits read through immutable snapshots while one writer changes it, the bits are kept in copy-on-write blocks, the writer copies only the blocks it changes and publishes them as a new version with one atomic pointer store, so the readers neither lock nor wait for the writer (read-copy-update)
+class SharedBitArray
+{
+private:
+  std::shared_ptr<const BitArraySnapshot::Version> published;
+  std::vector<std::shared_ptr<const unsigned long>> draft; // the blocks of the next version
+  std::vector<unsigned long *> writable;                   // the blocks copied since the last publish, nullptr for the blocks shared with a published version
+  int num_bits{0};
+  int bits_per_block{0};
+  int block_shift{0};
+  int num_copied{0}; // the number of non-null writable blocks
+
+  // returns the number of words of the k-index block, the last block holds only the words up to the last bit
+  int block_words(int k) const;
+  // allocates the k-index block aligned to a cache line, filled with the words at src or with false if src is nullptr
+  std::shared_ptr<unsigned long> allocate_block(int k, const unsigned long *src) const;
+  // returns the words of the k-index block of the draft, copies the block first if it is shared with a published version
+  unsigned long *write_block(int k);
+
+public:
+  static const int dim{sizeof(unsigned long) * 8};
+  // default number of bits in a block, one 4 KiB page
+  static const int default_block_bits{4096 * 8};
+
+  // creates an array of num_bits false bits in blocks of block_bits bits, works only when block_bits is a power of two and a multiple of dim, the initial version is published
+  explicit SharedBitArray(int num_bits, int block_bits = default_block_bits);
+  // creates an array with the bits of b in blocks of block_bits bits, works only when block_bits is a power of two and a multiple of dim, the initial version is published
+  explicit SharedBitArray(const BitArray &b, int block_bits = default_block_bits);
+
+  SharedBitArray(const SharedBitArray &) = delete;
+  SharedBitArray &operator=(const SharedBitArray &) = delete;
+
+  // returns the latest published version, safe to call from any thread at any time
+  BitArraySnapshot snapshot() const;
+
+  // returns the array size
+  int size() const;
+  // returns the number of bits in a block
+  int block_bits() const;
+  // returns the number of blocks copied since the last publish
+  int pending_blocks() const;
+
+  // the writer interface, to be called from one thread at a time, the changes are seen by the readers after publish
+
+  // returns the value of the i-index bit in the draft of the next version
+  bool test(int i) const;
+  // sets the n-index bit of the draft to val, copies its block once per publish
+  SharedBitArray &set(int n, bool val = true);
+  // sets the n-index bit of the draft to the value false
+  SharedBitArray &reset(int n);
+  // makes the draft equal to b, copies only the blocks whose bits differ, works only when array sizes match
+  SharedBitArray &assign(const BitArray &b);
+  // writes the changes of the delta to the draft, copies only the blocks of the changed ranges, works only when the delta source has the array size
+  SharedBitArray &apply_delta(const BitArrayDelta &delta);
+  // forgets the changes since the last publish
+  void discard();
+  // makes the draft the latest version with one atomic store, the blocks of the earlier versions are freed when their last snapshot is released, returns the version number
+  std::uint64_t publish();
+};
+
+// returns the array size
+inline int BitArraySnapshot::size() const
+{
+  return this->version == nullptr ? 0 : this->version->num_bits;
+}
+
+// returns true if the snapshot has no bits
+inline bool BitArraySnapshot::empty() const
+{
+  return (*this).size() == 0;
+}
+
+// returns the value of the i-index bit
+inline bool BitArraySnapshot::operator[](int i) const
+{
+  if ((*this).empty()) // the array empty check
+  {
+    throw std::invalid_argument("Error: array is empty");
+  }
+
+  if (i < 0 || i >= this->version->num_bits) // the index validitation check
+  {
+    throw std::out_of_range("Error: index is out of range");
+  }
+
+  const unsigned long *words = this->version->blocks[i >> this->version->block_shift].get(); // one more load than BitArray, the block pointer
+
+  return ((words[(i & (this->version->block_bits - 1)) / dim] >> (i % dim)) & 1UL) != 0UL;
+}
+
+#endif
@@ -0,0 +1,161 @@
+#include "bitarray_stats.hpp"
+
+#include <atomic>
+#include <memory>
+
+namespace
+{
+    std::atomic<bool> stats_enabled{false};
+
+    std::atomic<unsigned long long> allocations{0};
+    std::atomic<unsigned long long> deallocations{0};
+    std::atomic<unsigned long long> bytes_allocated{0};
+    std::atomic<unsigned long long> bytes_copied{0};
+    std::atomic<unsigned long long> reallocations{0};
+    std::atomic<unsigned long long> op_calls[bitarray_num_ops];
+    std::atomic<unsigned long long> op_words[bitarray_num_ops];
+
+    // an installed trace hook with its context, published whole and never changed after it, a thread that loaded it keeps it alive until its call returns
+    struct TraceHook
+    {
+        BitArrayTraceHook hook;
+        void *context;
+    };
+
+    std::shared_ptr<const TraceHook> trace_hook; // accessed only with std::atomic_load and std::atomic_store
+
+    const char *const op_names[bitarray_num_ops] = {
+        "construct", "copy_construct", "assign", "resize", "push_back", "set", "reset", "bit_and", "bit_or",
+        "bit_xor", "bit_not", "shift_left", "shift_right", "count", "any", "compare", "to_string", "hash",
+        "extract", "insert", "erase", "replace", "rotate", "batch", "arithmetic", "indices", "random", "all",
+        "bit_andnot"};
+}
+
+// returns true if the instrumentation is compiled in (BITARRAY_STATS is defined)
+bool bitarray_stats_available()
+{
+#ifdef BITARRAY_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+// enables or disables the counters at runtime, they are disabled by default
+void bitarray_stats_enable(bool enabled)
+{
+    stats_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// returns true if the counters are compiled in and enabled at runtime
+bool bitarray_stats_enabled()
+{
+    return bitarray_stats_available() && stats_enabled.load(std::memory_order_relaxed);
+}
+
+// returns a snapshot of the counters
+BitArrayStats bitarray_stats()
+{
+    BitArrayStats stats;
+
+    stats.allocations = allocations.load(std::memory_order_relaxed);
+    stats.deallocations = deallocations.load(std::memory_order_relaxed);
+    stats.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+    stats.bytes_copied = bytes_copied.load(std::memory_order_relaxed);
+    stats.reallocations = reallocations.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < bitarray_num_ops; ++i)
+    {
+        stats.calls[i] = op_calls[i].load(std::memory_order_relaxed);
+        stats.words[i] = op_words[i].load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
+// sets all counters to zero
+void bitarray_stats_reset()
+{
+    allocations.store(0, std::memory_order_relaxed);
+    deallocations.store(0, std::memory_order_relaxed);
+    bytes_allocated.store(0, std::memory_order_relaxed);
+    bytes_copied.store(0, std::memory_order_relaxed);
+    reallocations.store(0, std::memory_order_relaxed);
+
+    for (int i = 0; i < bitarray_num_ops; ++i)
+    {
+        op_calls[i].store(0, std::memory_order_relaxed);
+        op_words[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+// installs the trace hook, nullptr removes it, safe to call while other threads record operations, they call either the old hook with the old context or the new hook with the new context
+void bitarray_set_trace_hook(BitArrayTraceHook hook, void *context)
+{
+    std::shared_ptr<const TraceHook> installed;
+
+    if (hook != nullptr)
+        installed = std::make_shared<const TraceHook>(TraceHook{hook, context});
+
+    std::atomic_store(&trace_hook, std::move(installed)); // the replaced hook is freed when the last thread calling it lets it go
+}
+
+// returns the name of the operation op
+const char *bitarray_op_name(BitArrayOp op)
+{
+    int i = static_cast<int>(op);
+
+    if (i < 0 || i >= bitarray_num_ops) // the argument check
+        return "unknown";
+
+    return op_names[i];
+}
+
+void bitarray_record_alloc(std::size_t bytes)
+{
+    if (!stats_enabled.load(std::memory_order_relaxed))
+        return;
+
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void bitarray_record_dealloc()
+{
+    if (!stats_enabled.load(std::memory_order_relaxed))
+        return;
+
+    deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void bitarray_record_copy(std::size_t bytes)
+{
+    if (!stats_enabled.load(std::memory_order_relaxed))
+        return;
+
+    bytes_copied.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void bitarray_record_realloc()
+{
+    if (!stats_enabled.load(std::memory_order_relaxed))
+        return;
+
+    reallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void bitarray_record_op(BitArrayOp op, long long words)
+{
+    if (!stats_enabled.load(std::memory_order_relaxed))
+        return;
+
+    int i = static_cast<int>(op);
+
+    op_calls[i].fetch_add(1, std::memory_order_relaxed);
+    op_words[i].fetch_add(static_cast<unsigned long long>(words), std::memory_order_relaxed);
+
+    std::shared_ptr<const TraceHook> trace = std::atomic_load(&trace_hook); // the hook and its context are read from one published pair
+
+    if (trace != nullptr) // the trace hook is called only if it is installed
+        trace->hook(op, words, trace->context);
+}
@@ -0,0 +1,101 @@
+#ifndef BITARRAY_STATS_HPP
+#define BITARRAY_STATS_HPP
+
+#include <cstddef>
+
+// operations of the BitArray class tracked by the instrumentation counters
+enum class BitArrayOp
+{
+  construct,
+  copy_construct,
+  assign,
+  resize,
+  push_back,
+  set,
+  reset,
+  bit_and,
+  bit_or,
+  bit_xor,
+  bit_not,
+  shift_left,
+  shift_right,
+  count,
+  any,
+  compare,
+  to_string,
+  hash,
+  extract,
+  insert,
+  erase,
+  replace,
+  rotate,
+  batch,
+  arithmetic,
+  indices,
+  random,
+  all,
+  bit_andnot,
+  num_ops // the number of tracked operations, not an operation
+};
+
+// number of tracked operations, size of the per-operation counter arrays
+const int bitarray_num_ops = static_cast<int>(BitArrayOp::num_ops);
+
+// snapshot of the instrumentation counters
+struct BitArrayStats
+{
+  unsigned long long allocations{0};               // number of word arrays allocated
+  unsigned long long deallocations{0};             // number of word arrays freed
+  unsigned long long bytes_allocated{0};           // total size of the allocated word arrays in bytes
+  unsigned long long bytes_copied{0};              // bytes copied between word arrays (copies, assignments, reallocations)
+  unsigned long long reallocations{0};             // reallocations caused by push_back and resize
+  unsigned long long calls[bitarray_num_ops]{};    // number of calls per operation
+  unsigned long long words[bitarray_num_ops]{};    // number of words processed per operation
+
+  // returns the number of calls of the operation op
+  unsigned long long calls_of(BitArrayOp op) const { return calls[static_cast<int>(op)]; }
+  // returns the number of words processed by the operation op
+  unsigned long long words_of(BitArrayOp op) const { return words[static_cast<int>(op)]; }
+};
+
+// trace hook, called on every tracked operation with the number of words it processed and the user context
+typedef void (*BitArrayTraceHook)(BitArrayOp op, long long words, void *context);
+
+// returns true if the instrumentation is compiled in (BITARRAY_STATS is defined)
+bool bitarray_stats_available();
+// enables or disables the counters at runtime, they are disabled by default
+void bitarray_stats_enable(bool enabled);
+// returns true if the counters are compiled in and enabled at runtime
+bool bitarray_stats_enabled();
+// returns a snapshot of the counters
+BitArrayStats bitarray_stats();
+// sets all counters to zero
+void bitarray_stats_reset();
+// installs the trace hook, nullptr removes it, safe to call while other threads record operations, they call either the old hook with the old context or the new hook with the new context
+void bitarray_set_trace_hook(BitArrayTraceHook hook, void *context = nullptr);
+// returns the name of the operation op
+const char *bitarray_op_name(BitArrayOp op);
+
+// recording functions used by the BitArray implementation, do nothing while the counters are disabled
+void bitarray_record_alloc(std::size_t bytes);
+void bitarray_record_dealloc();
+void bitarray_record_copy(std::size_t bytes);
+void bitarray_record_realloc();
+void bitarray_record_op(BitArrayOp op, long long words);
+
+// the recording macros expand to nothing unless the library is built with BITARRAY_STATS
+#ifdef BITARRAY_STATS
+#define BITARRAY_RECORD_ALLOC(bytes) bitarray_record_alloc(bytes)
+#define BITARRAY_RECORD_DEALLOC() bitarray_record_dealloc()
+#define BITARRAY_RECORD_COPY(bytes) bitarray_record_copy(bytes)
+#define BITARRAY_RECORD_REALLOC() bitarray_record_realloc()
+#define BITARRAY_RECORD_OP(op, words) bitarray_record_op(op, words)
+#else
+#define BITARRAY_RECORD_ALLOC(bytes) ((void)0)
+#define BITARRAY_RECORD_DEALLOC() ((void)0)
+#define BITARRAY_RECORD_COPY(bytes) ((void)0)
+#define BITARRAY_RECORD_REALLOC() ((void)0)
+#define BITARRAY_RECORD_OP(op, words) ((void)0)
+#endif
+
+#endif
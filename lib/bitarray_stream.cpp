@@ -0,0 +1,298 @@
+#include "bitarray_stream.hpp"
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace
+{
+    // owning handle of an open file
+    using File = std::unique_ptr<std::FILE, int (*)(std::FILE *)>;
+
+    // opens the file in the mode, throws if it cannot be opened
+    File open_file(const std::string &path, const char *mode)
+    {
+        File file(std::fopen(path.c_str(), mode), &std::fclose);
+
+        if (file == nullptr) // the file open check
+        {
+            throw std::runtime_error("Error: cannot open file " + path);
+        }
+
+        return file;
+    }
+
+    // returns true if the host stores words with the lowest byte first, then the bytes of a file bitmap are the memory layout of the chunk words
+    bool host_is_little_endian()
+    {
+        const std::uint64_t probe = 1;
+
+        return *reinterpret_cast<const unsigned char *>(&probe) == 1;
+    }
+
+    // converts the words of the chunk between the little-endian 64-bit words of a file bitmap and the host order in place, the conversion is its own inverse and does nothing on little-endian hosts
+    void convert_words(BitArray &chunk)
+    {
+        if (host_is_little_endian())
+            return;
+
+        unsigned long *words = chunk.data();
+
+        for (int i = 0; i < chunk.size() / BitArray::dim; ++i)
+        {
+            const unsigned char *bytes = reinterpret_cast<const unsigned char *>(words + i);
+            unsigned long w = 0;
+
+            for (std::size_t j = 0; j < sizeof(unsigned long); ++j)
+                w |= static_cast<unsigned long>(bytes[j]) << (8 * j); // the byte j of the word in the file holds its bits [8j, 8j + 8)
+
+            words[i] = w;
+        }
+    }
+
+    // checks that the chunk size is a positive multiple of 8 bytes whose bits can be counted by an int
+    void check_chunk_bytes(int chunk_bytes)
+    {
+        if (chunk_bytes <= 0 || chunk_bytes % 8 != 0 || chunk_bytes > (1 << 27)) // the argument check
+        {
+            throw std::invalid_argument("Error: argument chunk_bytes expects a multiple of 8 in (0, 2^27]");
+        }
+    }
+
+    // reads the files chunk by chunk on a background thread into two alternating sets of buffers, the chunk k + 1 is read while the chunk k is processed
+    class ChunkReader
+    {
+    private:
+        // the buffers of one chunk, owned by the reader thread while full is false and by the consumer while it is true
+        struct Slot
+        {
+            std::vector<BitArray> chunks; // one buffer per file
+            std::size_t bytes{0};         // the number of bytes read into every buffer, 0 at the end of the files
+            bool full{false};
+        };
+
+        std::vector<std::FILE *> files;
+        int chunk_bytes;
+        Slot slots[2];
+        int current{-1}; // the slot held by the consumer, -1 before the first chunk
+
+        std::mutex mutex;
+        std::condition_variable ready;
+        bool stop{false};
+        std::exception_ptr error;
+        std::thread thread;
+
+        // reads the next chunk of every file into the slot, the bytes after the end of the files are false
+        std::size_t read(Slot &slot)
+        {
+            std::size_t bytes = 0;
+
+            for (std::size_t f = 0; f < this->files.size(); ++f)
+            {
+                unsigned char *buffer = reinterpret_cast<unsigned char *>(slot.chunks[f].data());
+                std::size_t n = std::fread(buffer, 1, this->chunk_bytes, this->files[f]);
+
+                if (std::ferror(this->files[f])) // the read error check
+                {
+                    throw std::runtime_error("Error: cannot read file");
+                }
+
+                std::memset(buffer + n, 0, this->chunk_bytes - n); // the incomplete last chunk is padded with false bits
+
+                convert_words(slot.chunks[f]); // the file bytes are little-endian words, the chunk holds host-order words
+
+                if (f == 0)
+                    bytes = n;
+                else if (n != bytes) // the files were checked to have equal sizes
+                {
+                    throw std::runtime_error("Error: file sizes do not match");
+                }
+            }
+
+            return bytes;
+        }
+
+        // the body of the reader thread, fills the slots in turn until the end of the files
+        void run()
+        {
+            for (int s = 0;; s ^= 1)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(this->mutex);
+                    this->ready.wait(lock, [&] { return !this->slots[s].full || this->stop; }); // waits until the consumer releases the slot
+
+                    if (this->stop)
+                        return;
+                }
+
+                std::size_t bytes = 0;
+                bool failed = false;
+
+                try
+                {
+                    bytes = (*this).read(this->slots[s]); // the slot is read without holding the lock
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    this->error = std::current_exception();
+                    failed = true;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    this->slots[s].bytes = failed ? 0 : bytes;
+                    this->slots[s].full = true;
+                }
+
+                this->ready.notify_all();
+
+                if (bytes == 0 || failed)
+                    return;
+            }
+        }
+
+    public:
+        ChunkReader(std::vector<std::FILE *> files, int chunk_bytes) : files(std::move(files)), chunk_bytes(chunk_bytes)
+        {
+            for (Slot &slot : this->slots)
+            {
+                for (std::size_t f = 0; f < this->files.size(); ++f)
+                    slot.chunks.emplace_back(chunk_bytes * 8);
+            }
+
+            this->thread = std::thread(&ChunkReader::run, this);
+        }
+
+        ~ChunkReader()
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->stop = true;
+            }
+
+            this->ready.notify_all();
+            this->thread.join();
+        }
+
+        // releases the current chunk and waits for the next one, returns its number of bytes, 0 at the end of the files
+        std::size_t next()
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+
+            if (this->current >= 0)
+            {
+                this->slots[this->current].full = false; // the reader may refill the released slot
+                this->ready.notify_all();
+            }
+
+            this->current = (this->current + 1) % 2;
+            this->ready.wait(lock, [&] { return this->slots[this->current].full; });
+
+            if (this->error) // the error of the reader thread is passed to the consumer
+                std::rethrow_exception(this->error);
+
+            return this->slots[this->current].bytes;
+        }
+
+        // returns the buffer of the current chunk of the file f, its bits after the read bytes are false
+        BitArray &chunk(int f)
+        {
+            return this->slots[this->current].chunks[f];
+        }
+    };
+}
+
+// counts the number of true bits of the file bitmap
+long long stream_count(const std::string &path, int chunk_bytes)
+{
+    check_chunk_bytes(chunk_bytes);
+
+    File file = open_file(path, "rb");
+    ChunkReader reader({file.get()}, chunk_bytes);
+    long long count = 0;
+
+    while (reader.next() != 0)
+    {
+        count += reader.chunk(0).count(); // the padding of the last chunk is false and is not counted
+    }
+
+    return count;
+}
+
+// writes op of the file bitmaps a and b to the file out, works only when file sizes match and out is not one of them
+void stream_combine(const std::string &a, const std::string &b, const std::string &out, StreamOp op, int chunk_bytes)
+{
+    check_chunk_bytes(chunk_bytes);
+
+    File file_a = open_file(a, "rb");
+    File file_b = open_file(b, "rb");
+
+    if (std::filesystem::file_size(a) != std::filesystem::file_size(b)) // the file sizes check
+    {
+        throw std::runtime_error("Error: file sizes do not match");
+    }
+
+    std::error_code error; // out does not have to exist, then it is not equivalent to either input
+
+    if (std::filesystem::equivalent(out, a, error) || std::filesystem::equivalent(out, b, error)) // the output check, opening out for writing would truncate an input before it is read
+    {
+        throw std::invalid_argument("Error: output file " + out + " is one of the input files");
+    }
+
+    File file_out = open_file(out, "wb");
+    ChunkReader reader({file_a.get(), file_b.get()}, chunk_bytes);
+
+    for (std::size_t bytes = reader.next(); bytes != 0; bytes = reader.next())
+    {
+        BitArray &chunk = reader.chunk(0);
+
+        switch (op) // the word-level operations of BitArray are applied to the whole chunk, the result replaces the chunk of a
+        {
+        case StreamOp::bit_and:
+            chunk &= reader.chunk(1);
+            break;
+        case StreamOp::bit_or:
+            chunk |= reader.chunk(1);
+            break;
+        case StreamOp::bit_xor:
+            chunk ^= reader.chunk(1);
+            break;
+        }
+
+        convert_words(chunk); // back to the little-endian words of the file
+
+        if (std::fwrite(chunk.data(), 1, bytes, file_out.get()) != bytes) // the results are written sequentially while the next chunk is being read
+        {
+            throw std::runtime_error("Error: cannot write file " + out);
+        }
+    }
+
+    if (std::fflush(file_out.get()) != 0) // the write error check
+    {
+        throw std::runtime_error("Error: cannot write file " + out);
+    }
+}
+
+// writes the bitwise multiplication of the file bitmaps a and b to the file out, works only when file sizes match and out is not one of them
+void stream_and(const std::string &a, const std::string &b, const std::string &out, int chunk_bytes)
+{
+    stream_combine(a, b, out, StreamOp::bit_and, chunk_bytes);
+}
+
+// writes the bitwise addition of the file bitmaps a and b to the file out, works only when file sizes match and out is not one of them
+void stream_or(const std::string &a, const std::string &b, const std::string &out, int chunk_bytes)
+{
+    stream_combine(a, b, out, StreamOp::bit_or, chunk_bytes);
+}
+
+// writes the exclusive-or of the file bitmaps a and b to the file out, works only when file sizes match and out is not one of them
+void stream_xor(const std::string &a, const std::string &b, const std::string &out, int chunk_bytes)
+{
+    stream_combine(a, b, out, StreamOp::bit_xor, chunk_bytes);
+}
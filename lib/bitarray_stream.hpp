@@ -0,0 +1,32 @@
+#ifndef BITARRAY_STREAM_HPP
+#define BITARRAY_STREAM_HPP
+
+#include "bitarray.hpp"
+
+// out-of-core operations over file bitmaps, a file bitmap holds the bytes written by BitArray::to_bytes or the words of BitArray::to_words stored little-endian, the n-index bit is the bit n % 8 of the byte n / 8 on every host
+// the files are processed in chunks of chunk_bytes bytes, a background thread reads the next chunk into a second buffer while the current one is processed, so at most 2 chunks per input file are held in memory
+
+// default size of a chunk in bytes
+const int stream_chunk_bytes = 1 << 20;
+
+// operation applied by stream_combine to the chunks of two file bitmaps
+enum class StreamOp
+{
+  bit_and, // bitwise multiplication
+  bit_or,  // bitwise addition
+  bit_xor  // exclusive-or
+};
+
+// counts the number of true bits of the file bitmap
+long long stream_count(const std::string &path, int chunk_bytes = stream_chunk_bytes);
+
+// writes op of the file bitmaps a and b to the file out, works only when file sizes match and out is not one of them
+void stream_combine(const std::string &a, const std::string &b, const std::string &out, StreamOp op, int chunk_bytes = stream_chunk_bytes);
+// writes the bitwise multiplication of the file bitmaps a and b to the file out, works only when file sizes match and out is not one of them
+void stream_and(const std::string &a, const std::string &b, const std::string &out, int chunk_bytes = stream_chunk_bytes);
+// writes the bitwise addition of the file bitmaps a and b to the file out, works only when file sizes match and out is not one of them
+void stream_or(const std::string &a, const std::string &b, const std::string &out, int chunk_bytes = stream_chunk_bytes);
+// writes the exclusive-or of the file bitmaps a and b to the file out, works only when file sizes match and out is not one of them
+void stream_xor(const std::string &a, const std::string &b, const std::string &out, int chunk_bytes = stream_chunk_bytes);
+
+#endif
@@ -0,0 +1,515 @@
+#include "bitarray_view.hpp"
+#include "bitarray_words.hpp"
+
+const int BitArrayView::dim;
+const int BitArraySpan::dim;
+
+// returns the bits [i * dim, i * dim + dim) of the window as one word, the bits after the end of the window are false
+unsigned long BitArrayView::load(int i) const
+{
+    return bitarray_words::load(this->words, this->offset + static_cast<long long>(i) * dim, static_cast<long long>(this->offset) + this->length);
+}
+
+// default constructor, creates an empty view
+BitArrayView::BitArrayView() {}
+
+// creates a view of length bits of the word array starting at the bit offset, the words are stored LSB-first like in BitArray
+BitArrayView::BitArrayView(const unsigned long *words, int offset, int length) : words(words), offset(offset), length(length)
+{
+    if (offset < 0 || length < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: arguments offset and length expect values >= 0");
+    }
+
+    if (words == nullptr && length > 0) // the word array check
+    {
+        throw std::invalid_argument("Error: word array is null");
+    }
+}
+
+// creates a view of the whole array b
+BitArrayView::BitArrayView(const BitArray &b) : words(b.data()), offset(0), length(b.size()) {}
+
+// creates a view of len bits of the array b starting at the pos-index bit
+BitArrayView::BitArrayView(const BitArray &b, int pos, int len) : words(b.data()), offset(pos), length(len)
+{
+    if (pos < 0 || len < 0 || pos > b.size() - len) // the window validitation check
+    {
+        throw std::out_of_range("Error: window is out of range");
+    }
+}
+
+// returns a view of len bits of this view starting at the pos-index bit
+BitArrayView BitArrayView::subview(int pos, int len) const
+{
+    if (pos < 0 || len < 0 || pos > this->length - len) // the window validitation check
+    {
+        throw std::out_of_range("Error: window is out of range");
+    }
+
+    return BitArrayView(this->words, this->offset + pos, len);
+}
+
+// returns the value of the i-index bit
+bool BitArrayView::operator[](int i) const
+{
+    if ((*this).empty()) // the view empty check
+    {
+        throw std::invalid_argument("Error: view is empty");
+    }
+
+    if (i < 0 || i >= this->length) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    int n = this->offset + i;
+
+    return ((this->words[n / dim] >> (n % dim)) & 1UL) != 0UL;
+}
+
+// returns the view size
+int BitArrayView::size() const
+{
+    return this->length;
+}
+
+// returns true if the view has no bits
+bool BitArrayView::empty() const
+{
+    return this->length == 0;
+}
+
+// return true if the view contains one or more true bits
+bool BitArrayView::any() const
+{
+    if ((*this).empty()) // the view empty check
+    {
+        throw std::invalid_argument("Error: view is empty");
+    }
+
+    for (int i = 0; i < (this->length + dim - 1) / dim; ++i)
+    {
+        if ((*this).load(i) != 0UL) // if at least one word of the window is not 0, return true
+            return true;
+    }
+
+    return false;
+}
+
+// returns true if all bits of the view are false
+bool BitArrayView::none() const
+{
+    return !(*this).any(); // returns negated any
+}
+
+// returns true if all bits of the view are true
+bool BitArrayView::all() const
+{
+    if ((*this).empty()) // the view empty check
+    {
+        throw std::invalid_argument("Error: view is empty");
+    }
+
+    for (int i = 0; i < this->length / dim; ++i)
+    {
+        if ((*this).load(i) != ~0UL) // every full word of the window must consist of true bits only
+            return false;
+    }
+
+    if (this->length % dim != 0)
+    {
+        unsigned long mask = bitarray_words::low_mask<unsigned long>(this->length % dim);
+
+        return (*this).load(this->length / dim) == mask; // the incomplete last word is compared with the mask of its bits
+    }
+
+    return true;
+}
+
+// counts the number of true bits
+int BitArrayView::count() const
+{
+    if ((*this).empty()) // the view empty check
+    {
+        throw std::invalid_argument("Error: view is empty");
+    }
+
+    int count = 0;
+
+    for (int i = 0; i < (this->length + dim - 1) / dim; ++i)
+    {
+        count += bitarray_words::popcount((*this).load(i)); // counting true values in each word of the window
+    }
+
+    return count;
+}
+
+// returns the index of the first true bit, -1 if there is none
+int BitArrayView::find_first() const
+{
+    return (*this).find_next(-1);
+}
+
+// returns the index of the first true bit after the pos-index bit, -1 if there is none
+int BitArrayView::find_next(int pos) const
+{
+    if (pos < -1) // the argument check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    int first = pos + 1;
+
+    if (first >= this->length)
+        return -1;
+
+    int i = first / dim;
+    unsigned long w = (*this).load(i) & ~bitarray_words::low_mask<unsigned long>(first % dim); // the bits before the first candidate are cleared
+
+    while (true)
+    {
+        if (w != 0UL)
+            return i * dim + bitarray_words::ctz(w); // the lowest true bit of the word is found with a single instruction
+
+        if (++i >= (this->length + dim - 1) / dim)
+            return -1;
+
+        w = (*this).load(i);
+    }
+}
+
+// returns the view as a string
+std::string BitArrayView::to_string() const
+{
+    if ((*this).empty()) // the view empty check
+    {
+        throw std::invalid_argument("Error: view is empty");
+    }
+
+    std::string str(this->length, '0');
+
+    for (int i = 0; i < this->length; i += dim)
+    {
+        unsigned long w = (*this).load(i / dim);
+
+        for (int j = 0; j < dim && i + j < this->length; ++j)
+        {
+            if ((w >> j) & 1UL) // if the value is true, the character is 1
+                str[i + j] = '1';
+        }
+    }
+
+    return str;
+}
+
+// copies the bits of the view to a new object of class BitArray
+BitArray BitArrayView::to_bitarray() const
+{
+    BitArray new_object(this->length);
+
+    if (!(*this).empty())
+    {
+        bitarray_words::copy(new_object.data(), 0, this->words, this->offset, this->length); // the window is copied a word at a time
+    }
+
+    return new_object;
+}
+
+// returns the pointer to the viewed words
+const unsigned long *BitArrayView::data() const
+{
+    return this->words;
+}
+
+// returns the bit offset of the view in the viewed words
+int BitArrayView::bit_offset() const
+{
+    return this->offset;
+}
+
+// checks that the span and the view are not empty and have equal sizes
+void BitArraySpan::check_operand(const BitArrayView &b) const
+{
+    if ((*this).empty()) // the span empty check
+    {
+        throw std::invalid_argument("Error: this span is empty");
+    }
+
+    if (b.empty()) // the view empty check
+    {
+        throw std::invalid_argument("Error: other view is empty");
+    }
+
+    if (this->length != b.size()) // the sizes check
+    {
+        throw std::runtime_error("Error: sizes do not match");
+    }
+}
+
+// default constructor, creates an empty span
+BitArraySpan::BitArraySpan() {}
+
+// creates a span of length bits of the word array starting at the bit offset, the words are stored LSB-first like in BitArray
+BitArraySpan::BitArraySpan(unsigned long *words, int offset, int length) : words(words), offset(offset), length(length)
+{
+    if (offset < 0 || length < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: arguments offset and length expect values >= 0");
+    }
+
+    if (words == nullptr && length > 0) // the word array check
+    {
+        throw std::invalid_argument("Error: word array is null");
+    }
+}
+
+// creates a span of the whole array b
+BitArraySpan::BitArraySpan(BitArray &b) : words(b.data()), offset(0), length(b.size()) {}
+
+// creates a span of len bits of the array b starting at the pos-index bit
+BitArraySpan::BitArraySpan(BitArray &b, int pos, int len) : words(b.data()), offset(pos), length(len)
+{
+    if (pos < 0 || len < 0 || pos > b.size() - len) // the window validitation check
+    {
+        throw std::out_of_range("Error: window is out of range");
+    }
+}
+
+// returns a span of len bits of this span starting at the pos-index bit
+BitArraySpan BitArraySpan::subspan(int pos, int len) const
+{
+    if (pos < 0 || len < 0 || pos > this->length - len) // the window validitation check
+    {
+        throw std::out_of_range("Error: window is out of range");
+    }
+
+    return BitArraySpan(this->words, this->offset + pos, len);
+}
+
+// returns a read-only view of the span
+BitArrayView BitArraySpan::view() const
+{
+    return BitArrayView(this->words, this->offset, this->length);
+}
+
+// converts the span to a read-only view
+BitArraySpan::operator BitArrayView() const
+{
+    return (*this).view();
+}
+
+// copies the bits of the view b to the span, works only when sizes match
+BitArraySpan &BitArraySpan::assign(const BitArrayView &b)
+{
+    (*this).check_operand(b);
+
+    bitarray_words::copy(this->words, this->offset, b.data(), b.bit_offset(), this->length); // the bits are copied a word at a time
+
+    return *this;
+}
+
+// bitwise multiplication with the view b, works only when sizes match, result is assigned to the span
+BitArraySpan &BitArraySpan::operator&=(const BitArrayView &b)
+{
+    (*this).check_operand(b);
+
+    bitarray_words::combine(this->words, this->offset, b.data(), b.bit_offset(), this->length,
+                            [](unsigned long x, unsigned long y) { return x & y; }); // applying the operation to each pair of words of the windows
+
+    return *this;
+}
+
+// bitwise addition with the view b, works only when sizes match, result is assigned to the span
+BitArraySpan &BitArraySpan::operator|=(const BitArrayView &b)
+{
+    (*this).check_operand(b);
+
+    bitarray_words::combine(this->words, this->offset, b.data(), b.bit_offset(), this->length,
+                            [](unsigned long x, unsigned long y) { return x | y; }); // applying the operation to each pair of words of the windows
+
+    return *this;
+}
+
+// exclusive-or with the view b, works only when sizes match, result is assigned to the span
+BitArraySpan &BitArraySpan::operator^=(const BitArrayView &b)
+{
+    (*this).check_operand(b);
+
+    bitarray_words::combine(this->words, this->offset, b.data(), b.bit_offset(), this->length,
+                            [](unsigned long x, unsigned long y) { return x ^ y; }); // applying the operation to each pair of words of the windows
+
+    return *this;
+}
+
+// sets the n-index bit to val
+BitArraySpan &BitArraySpan::set(int n, bool val)
+{
+    if ((*this).empty()) // the span empty check
+    {
+        throw std::invalid_argument("Error: span is empty");
+    }
+
+    if (n < 0 || n >= this->length) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    int i = this->offset + n;
+
+    if (val)
+        this->words[i / dim] |= 1UL << (i % dim);
+    else
+        this->words[i / dim] &= ~(1UL << (i % dim));
+
+    return *this;
+}
+
+// fills the span with true values
+BitArraySpan &BitArraySpan::set()
+{
+    if ((*this).empty()) // the span empty check
+    {
+        throw std::invalid_argument("Error: span is empty");
+    }
+
+    bitarray_words::fill(this->words, this->offset, static_cast<long long>(this->offset) + this->length, true);
+
+    return *this;
+}
+
+// sets the n-index bit to the value false
+BitArraySpan &BitArraySpan::reset(int n)
+{
+    return (*this).set(n, false);
+}
+
+// fills the span with false values
+BitArraySpan &BitArraySpan::reset()
+{
+    if ((*this).empty()) // the span empty check
+    {
+        throw std::invalid_argument("Error: span is empty");
+    }
+
+    bitarray_words::fill(this->words, this->offset, static_cast<long long>(this->offset) + this->length, false);
+
+    return *this;
+}
+
+// inverts all bits of the span
+BitArraySpan &BitArraySpan::flip()
+{
+    if ((*this).empty()) // the span empty check
+    {
+        throw std::invalid_argument("Error: span is empty");
+    }
+
+    bitarray_words::combine(this->words, this->offset, this->words, this->offset, this->length,
+                            [](unsigned long x, unsigned long) { return ~x; }); // each word of the window is negated
+
+    return *this;
+}
+
+// returns the value of the i-index bit
+bool BitArraySpan::operator[](int i) const
+{
+    return (*this).view()[i];
+}
+
+// returns the span size
+int BitArraySpan::size() const
+{
+    return this->length;
+}
+
+// returns true if the span has no bits
+bool BitArraySpan::empty() const
+{
+    return this->length == 0;
+}
+
+// return true if the span contains one or more true bits
+bool BitArraySpan::any() const
+{
+    return (*this).view().any();
+}
+
+// returns true if all bits of the span are false
+bool BitArraySpan::none() const
+{
+    return (*this).view().none();
+}
+
+// returns true if all bits of the span are true
+bool BitArraySpan::all() const
+{
+    return (*this).view().all();
+}
+
+// counts the number of true bits
+int BitArraySpan::count() const
+{
+    return (*this).view().count();
+}
+
+// returns the index of the first true bit, -1 if there is none
+int BitArraySpan::find_first() const
+{
+    return (*this).view().find_first();
+}
+
+// returns the index of the first true bit after the pos-index bit, -1 if there is none
+int BitArraySpan::find_next(int pos) const
+{
+    return (*this).view().find_next(pos);
+}
+
+// returns the span as a string
+std::string BitArraySpan::to_string() const
+{
+    return (*this).view().to_string();
+}
+
+// returns the pointer to the spanned words
+unsigned long *BitArraySpan::data() const
+{
+    return this->words;
+}
+
+// returns the bit offset of the span in the spanned words
+int BitArraySpan::bit_offset() const
+{
+    return this->offset;
+}
+
+// equality operator, return true if the views are the same, works only when view sizes match
+bool operator==(const BitArrayView &a, const BitArrayView &b)
+{
+    if (a.empty() && b.empty())
+        return true;
+
+    if (a.size() != b.size()) // the sizes check
+    {
+        throw std::runtime_error("Error: sizes do not match");
+    }
+
+    const int dim = BitArrayView::dim;
+
+    for (int i = 0; i < a.size(); i += dim)
+    {
+        long long end = static_cast<long long>(a.size());
+
+        if (bitarray_words::load(a.data(), a.bit_offset() + static_cast<long long>(i), a.bit_offset() + end) !=
+            bitarray_words::load(b.data(), b.bit_offset() + static_cast<long long>(i), b.bit_offset() + end)) // checking equality of each pair of words of the windows
+            return false;
+    }
+
+    return true;
+}
+
+// inequality operator, return true if the views are not the same, works only when view sizes match
+bool operator!=(const BitArrayView &a, const BitArrayView &b)
+{
+    return !(a == b); // returns negated a == b
+}
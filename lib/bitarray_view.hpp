@@ -0,0 +1,150 @@
+#ifndef BITARRAY_VIEW_HPP
+#define BITARRAY_VIEW_HPP
+
+#include "bitarray.hpp"
+
+// non-owning read-only window of length bits starting at bit offset of a word array, the words are not copied
+class BitArrayView
+{
+private:
+  const unsigned long *words{nullptr};
+  int offset{0};
+  int length{0};
+
+  // returns the bits [i * dim, i * dim + dim) of the window as one word, the bits after the end of the window are false
+  unsigned long load(int i) const;
+
+public:
+  static const int dim{sizeof(unsigned long) * 8};
+
+  // default constructor, creates an empty view
+  BitArrayView();
+  // creates a view of length bits of the word array starting at the bit offset, the words are stored LSB-first like in BitArray
+  BitArrayView(const unsigned long *words, int offset, int length);
+  // creates a view of the whole array b
+  BitArrayView(const BitArray &b);
+  // creates a view of len bits of the array b starting at the pos-index bit
+  BitArrayView(const BitArray &b, int pos, int len);
+
+  // returns a view of len bits of this view starting at the pos-index bit
+  BitArrayView subview(int pos, int len) const;
+
+  // returns the value of the i-index bit
+  bool operator[](int i) const;
+
+  // returns the view size
+  int size() const;
+  // returns true if the view has no bits
+  bool empty() const;
+
+  // return true if the view contains one or more true bits
+  bool any() const;
+  // returns true if all bits of the view are false
+  bool none() const;
+  // returns true if all bits of the view are true
+  bool all() const;
+  // counts the number of true bits
+  int count() const;
+
+  // returns the index of the first true bit, -1 if there is none
+  int find_first() const;
+  // returns the index of the first true bit after the pos-index bit, -1 if there is none
+  int find_next(int pos) const;
+
+  // returns the view as a string
+  std::string to_string() const;
+  // copies the bits of the view to a new object of class BitArray
+  BitArray to_bitarray() const;
+
+  // returns the pointer to the viewed words
+  const unsigned long *data() const;
+  // returns the bit offset of the view in the viewed words
+  int bit_offset() const;
+};
+
+// non-owning mutable window of length bits starting at bit offset of a word array, the in-place operations change the viewed words
+class BitArraySpan
+{
+private:
+  unsigned long *words{nullptr};
+  int offset{0};
+  int length{0};
+
+  // checks that the span and the view are not empty and have equal sizes
+  void check_operand(const BitArrayView &b) const;
+
+public:
+  static const int dim{sizeof(unsigned long) * 8};
+
+  // default constructor, creates an empty span
+  BitArraySpan();
+  // creates a span of length bits of the word array starting at the bit offset, the words are stored LSB-first like in BitArray
+  BitArraySpan(unsigned long *words, int offset, int length);
+  // creates a span of the whole array b
+  BitArraySpan(BitArray &b);
+  // creates a span of len bits of the array b starting at the pos-index bit
+  BitArraySpan(BitArray &b, int pos, int len);
+
+  // returns a span of len bits of this span starting at the pos-index bit
+  BitArraySpan subspan(int pos, int len) const;
+  // returns a read-only view of the span
+  BitArrayView view() const;
+  // converts the span to a read-only view
+  operator BitArrayView() const;
+
+  // copies the bits of the view b to the span, works only when sizes match
+  BitArraySpan &assign(const BitArrayView &b);
+
+  // bitwise multiplication with the view b, works only when sizes match, result is assigned to the span
+  BitArraySpan &operator&=(const BitArrayView &b);
+  // bitwise addition with the view b, works only when sizes match, result is assigned to the span
+  BitArraySpan &operator|=(const BitArrayView &b);
+  // exclusive-or with the view b, works only when sizes match, result is assigned to the span
+  BitArraySpan &operator^=(const BitArrayView &b);
+
+  // sets the n-index bit to val
+  BitArraySpan &set(int n, bool val = true);
+  // fills the span with true values
+  BitArraySpan &set();
+  // sets the n-index bit to the value false
+  BitArraySpan &reset(int n);
+  // fills the span with false values
+  BitArraySpan &reset();
+  // inverts all bits of the span
+  BitArraySpan &flip();
+
+  // returns the value of the i-index bit
+  bool operator[](int i) const;
+
+  // returns the span size
+  int size() const;
+  // returns true if the span has no bits
+  bool empty() const;
+
+  // return true if the span contains one or more true bits
+  bool any() const;
+  // returns true if all bits of the span are false
+  bool none() const;
+  // returns true if all bits of the span are true
+  bool all() const;
+  // counts the number of true bits
+  int count() const;
+  // returns the index of the first true bit, -1 if there is none
+  int find_first() const;
+  // returns the index of the first true bit after the pos-index bit, -1 if there is none
+  int find_next(int pos) const;
+  // returns the span as a string
+  std::string to_string() const;
+
+  // returns the pointer to the spanned words
+  unsigned long *data() const;
+  // returns the bit offset of the span in the spanned words
+  int bit_offset() const;
+};
+
+// equality operator, return true if the views are the same, works only when view sizes match
+bool operator==(const BitArrayView &a, const BitArrayView &b);
+// inequality operator, return true if the views are not the same, works only when view sizes match
+bool operator!=(const BitArrayView &a, const BitArrayView &b);
+
+#endif
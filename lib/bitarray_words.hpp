@@ -0,0 +1,592 @@
+#ifndef BITARRAY_WORDS_HPP
+#define BITARRAY_WORDS_HPP
+
+#include <climits>
+
+#if (defined(__x86_64__) && defined(__LP64__) && (defined(__GNUC__) || defined(__clang__))) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__x86_64__) && defined(__LP64__) && (defined(__GNUC__) || defined(__clang__))
+#define BITARRAY_WORDS_ADDCARRY // unsigned long is 64-bit and _addcarry_u64/_subborrow_u64 are available
+#endif
+
+// word-level helpers shared by the BitArray kernels, bits are stored LSB-first: bit i of the array is bit i % W of word i / W
+namespace bitarray_words
+{
+  // returns the number of bits in a word
+  template <typename Word>
+  constexpr int bits()
+  {
+    return static_cast<int>(sizeof(Word) * CHAR_BIT);
+  }
+
+  // counts the number of true bits in the word
+  inline int popcount(unsigned long long w)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(w);
+#else
+    int count = 0;
+
+    for (; w != 0; w &= w - 1) // every iteration clears the lowest true bit
+      ++count;
+
+    return count;
+#endif
+  }
+
+  // returns the index of the lowest true bit, the word must not be 0
+  inline int ctz(unsigned long long w)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(w);
+#else
+    int n = 0;
+
+    for (; (w & 1ULL) == 0; w >>= 1)
+      ++n;
+
+    return n;
+#endif
+  }
+
+  // returns the index of the highest true bit, the word must not be 0
+  inline int msb(unsigned long long w)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(w);
+#else
+    int n = 0;
+
+    for (; w >>= 1;)
+      ++n;
+
+    return n;
+#endif
+  }
+
+#if defined(__SIZEOF_INT128__)
+  // counts the number of true bits in the 128-bit word
+  inline int popcount(unsigned __int128 w)
+  {
+    return popcount(static_cast<unsigned long long>(w)) + popcount(static_cast<unsigned long long>(w >> 64));
+  }
+
+  // returns the index of the lowest true bit of the 128-bit word, the word must not be 0
+  inline int ctz(unsigned __int128 w)
+  {
+    unsigned long long low = static_cast<unsigned long long>(w);
+
+    return low != 0 ? ctz(low) : 64 + ctz(static_cast<unsigned long long>(w >> 64));
+  }
+
+  // returns the index of the highest true bit of the 128-bit word, the word must not be 0
+  inline int msb(unsigned __int128 w)
+  {
+    unsigned long long high = static_cast<unsigned long long>(w >> 64);
+
+    return high != 0 ? 64 + msb(high) : msb(static_cast<unsigned long long>(w));
+  }
+#endif
+
+  // counts the number of true bits in a word of at most 64 bits
+  template <typename Word>
+  inline int popcount(Word w)
+  {
+    return popcount(static_cast<unsigned long long>(w));
+  }
+
+  // returns the index of the lowest true bit of a word of at most 64 bits, the word must not be 0
+  template <typename Word>
+  inline int ctz(Word w)
+  {
+    return ctz(static_cast<unsigned long long>(w));
+  }
+
+  // returns the index of the highest true bit of a word of at most 64 bits, the word must not be 0
+  template <typename Word>
+  inline int msb(Word w)
+  {
+    return msb(static_cast<unsigned long long>(w));
+  }
+
+  // hints the processor to load the cache line of the address ahead of its use
+  inline void prefetch(const void *address)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+  }
+
+  // returns a word with the n lowest bits set, 0 <= n <= bits<Word>()
+  template <typename Word>
+  inline Word low_mask(int n)
+  {
+    return n >= bits<Word>() ? static_cast<Word>(~Word(0)) : static_cast<Word>((Word(1) << n) - 1);
+  }
+
+  // returns a + b + carry and sets carry to the carry out, carry is 0 or 1
+  inline unsigned long add_carry(unsigned long a, unsigned long b, unsigned char &carry)
+  {
+#if defined(BITARRAY_WORDS_ADDCARRY)
+    unsigned long long sum;
+    carry = _addcarry_u64(carry, a, b, &sum); // compiles to adc
+    return static_cast<unsigned long>(sum);
+#else
+    unsigned long sum = a + b;
+    unsigned char out = sum < a;
+    sum += carry;
+    carry = static_cast<unsigned char>(out | (sum < carry));
+    return sum;
+#endif
+  }
+
+  // returns a - b - borrow and sets borrow to the borrow out, borrow is 0 or 1
+  inline unsigned long sub_borrow(unsigned long a, unsigned long b, unsigned char &borrow)
+  {
+#if defined(BITARRAY_WORDS_ADDCARRY)
+    unsigned long long difference;
+    borrow = _subborrow_u64(borrow, a, b, &difference); // compiles to sbb
+    return static_cast<unsigned long>(difference);
+#else
+    unsigned long difference = a - b;
+    unsigned char out = a < b;
+    out |= difference < borrow;
+    difference -= borrow;
+    borrow = out;
+    return difference;
+#endif
+  }
+
+  // returns the low word of a * b and writes the high word to high
+  inline unsigned long mul_wide(unsigned long a, unsigned long b, unsigned long &high)
+  {
+#if defined(__SIZEOF_INT128__) && defined(__LP64__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b; // compiles to one mul
+    high = static_cast<unsigned long>(product >> 64);
+    return static_cast<unsigned long>(product);
+#else
+    const int half = bits<unsigned long>() / 2;
+    const unsigned long mask = low_mask<unsigned long>(half);
+
+    unsigned long ll = (a & mask) * (b & mask);
+    unsigned long lh = (a & mask) * (b >> half);
+    unsigned long hl = (a >> half) * (b & mask);
+    unsigned long hh = (a >> half) * (b >> half);
+    unsigned long middle = (ll >> half) + (lh & mask) + (hl & mask); // the sum of the middle half-words and the carry of the low product
+
+    high = hh + (lh >> half) + (hl >> half) + (middle >> half);
+    return (middle << half) | (ll & mask);
+#endif
+  }
+
+  // returns a + b + carry and sets carry to the carry out for a word of any width, carry is 0 or 1
+  template <typename Word>
+  inline Word add_carry(Word a, Word b, unsigned char &carry)
+  {
+    Word sum = static_cast<Word>(a + b);
+    unsigned char out = sum < a;
+    sum = static_cast<Word>(sum + carry);
+    carry = static_cast<unsigned char>(out | (sum < carry));
+    return sum;
+  }
+
+  // returns a - b - borrow and sets borrow to the borrow out for a word of any width, borrow is 0 or 1
+  template <typename Word>
+  inline Word sub_borrow(Word a, Word b, unsigned char &borrow)
+  {
+    Word difference = static_cast<Word>(a - b);
+    unsigned char out = a < b;
+    out |= difference < borrow;
+    difference = static_cast<Word>(difference - borrow);
+    borrow = out;
+    return difference;
+  }
+
+  // returns the low word of a * b and writes the high word to high for a word of any width, the product is built from half-words
+  template <typename Word>
+  inline Word mul_wide(Word a, Word b, Word &high)
+  {
+    const int half = bits<Word>() / 2;
+    const Word mask = low_mask<Word>(half);
+
+    Word ll = static_cast<Word>((a & mask) * (b & mask));
+    Word lh = static_cast<Word>((a & mask) * (b >> half));
+    Word hl = static_cast<Word>((a >> half) * (b & mask));
+    Word hh = static_cast<Word>((a >> half) * (b >> half));
+    Word middle = static_cast<Word>((ll >> half) + (lh & mask) + (hl & mask)); // the sum of the middle half-words and the carry of the low product
+
+    high = static_cast<Word>(hh + (lh >> half) + (hl >> half) + (middle >> half));
+    return static_cast<Word>((middle << half) | (ll & mask));
+  }
+
+  // calls f with the index of every true bit of the num_words words in ascending order, each step costs one ctz and one clear of the lowest bit
+  template <typename Word, typename F>
+  inline void for_each_one(const Word *words, long long num_words, F f)
+  {
+    for (long long i = 0; i < num_words; ++i)
+    {
+      for (Word w = words[i]; w != 0; w = static_cast<Word>(w & (w - 1)))
+        f(i * bits<Word>() + ctz(w));
+    }
+  }
+
+  // returns the position of the k-index true bit of w, works only when k < popcount(w)
+  inline int select(unsigned long long w, int k)
+  {
+#if defined(__BMI2__)
+    return ctz(_pdep_u64(1ULL << k, w)); // pdep moves the k-index bit of the mask to the k-index true bit of w
+#else
+    for (; k > 0; --k)
+      w &= w - 1;
+
+    return ctz(w);
+#endif
+  }
+
+#if defined(__SIZEOF_INT128__)
+  // returns the position of the k-index true bit of the 128-bit word w, works only when k < popcount(w)
+  inline int select(unsigned __int128 w, int k)
+  {
+    unsigned long long low = static_cast<unsigned long long>(w);
+    int low_count = popcount(low);
+
+    return k < low_count ? select(low, k) : 64 + select(static_cast<unsigned long long>(w >> 64), k - low_count);
+  }
+#endif
+
+  // returns the position of the k-index true bit of a word of at most 64 bits, works only when k < popcount(w)
+  template <typename Word>
+  inline int select(Word w, int k)
+  {
+    return select(static_cast<unsigned long long>(w), k);
+  }
+
+  // reverses the order of bits in the word
+  template <typename Word>
+  inline Word reverse(Word w)
+  {
+    Word r = 0;
+
+    for (int i = 0; i < bits<Word>(); ++i, w >>= 1)
+      r = static_cast<Word>((r << 1) | (w & 1));
+
+    return r;
+  }
+
+  // returns the number of words needed to hold num_bits bits
+  template <typename Word>
+  inline long long words_for(long long num_bits)
+  {
+    return (num_bits + bits<Word>() - 1) / bits<Word>();
+  }
+
+  // returns the bits [pos, pos + W) of the word array as one word, bits at or after end are read as false
+  template <typename Word>
+  inline Word load(const Word *words, long long pos, long long end)
+  {
+    const int W = bits<Word>();
+    long long i = pos / W;
+    int r = static_cast<int>(pos % W);
+
+    Word w = static_cast<Word>(words[i] >> r);
+
+    if (r != 0 && (i + 1) * W < end)
+      w |= static_cast<Word>(words[i + 1] << (W - r)); // funnel shift with the next word
+
+    if (end - pos < W)
+      w &= low_mask<Word>(static_cast<int>(end - pos)); // the bits after end are cleared
+
+    return w;
+  }
+
+  // writes the len lowest bits of value to the bits [pos, pos + len) of the word array, 0 < len <= W
+  template <typename Word>
+  inline void store(Word *words, long long pos, Word value, int len)
+  {
+    const int W = bits<Word>();
+    long long i = pos / W;
+    int r = static_cast<int>(pos % W);
+
+    value &= low_mask<Word>(len);
+
+    Word mask = static_cast<Word>(low_mask<Word>(len) << r);
+    words[i] = static_cast<Word>((words[i] & ~mask) | (value << r));
+
+    if (r + len > W)
+    {
+      int rest = r + len - W; // the number of bits spilling into the next word
+      Word mask_next = low_mask<Word>(rest);
+      words[i + 1] = static_cast<Word>((words[i + 1] & ~mask_next) | (value >> (W - r)));
+    }
+  }
+
+  // copies len bits from src starting at src_pos to dst starting at dst_pos, the ranges may overlap
+  template <typename Word>
+  inline void copy(Word *dst, long long dst_pos, const Word *src, long long src_pos, long long len)
+  {
+    const int W = bits<Word>();
+
+    if (len <= 0)
+      return;
+
+    if (dst == src && dst_pos > src_pos && dst_pos < src_pos + len)
+    {
+      for (long long k = len; k > 0; k -= W) // overlapping copy to the right is done from the end
+      {
+        int n = static_cast<int>(k < W ? k : W);
+        store(dst, dst_pos + k - n, load(src, src_pos + k - n, src_pos + k), n);
+      }
+    }
+    else
+    {
+      for (long long k = 0; k < len; k += W)
+      {
+        int n = static_cast<int>(len - k < W ? len - k : W);
+        store(dst, dst_pos + k, load(src, src_pos + k, src_pos + len), n);
+      }
+    }
+  }
+
+  // sets the bits [first, last) of the word array to val
+  template <typename Word>
+  inline void fill(Word *words, long long first, long long last, bool val)
+  {
+    const int W = bits<Word>();
+    Word pattern = val ? static_cast<Word>(~Word(0)) : Word(0);
+
+    while (first < last && first % W != 0) // the incomplete first word
+    {
+      int n = static_cast<int>(W - first % W);
+      if (n > last - first)
+        n = static_cast<int>(last - first);
+      store(words, first, pattern, n);
+      first += n;
+    }
+
+    for (; first + W <= last; first += W)
+      words[first / W] = pattern; // full words are written at once
+
+    if (first < last)
+      store(words, first, pattern, static_cast<int>(last - first)); // the incomplete last word
+  }
+
+  // applies op(dst_bits, src_bits) to len bits of dst starting at dst_pos and of src starting at src_pos a word at a time, the ranges may overlap
+  template <typename Word, typename Op>
+  inline void combine(Word *dst, long long dst_pos, const Word *src, long long src_pos, long long len, Op op)
+  {
+    const int W = bits<Word>();
+
+    if (len <= 0)
+      return;
+
+    if (dst == src && dst_pos > src_pos && dst_pos < src_pos + len)
+    {
+      for (long long k = len; k > 0; k -= W) // overlapping ranges with the destination on the right are processed from the end
+      {
+        int n = static_cast<int>(k < W ? k : W);
+        Word a = load(static_cast<const Word *>(dst), dst_pos + k - n, dst_pos + k);
+        store(dst, dst_pos + k - n, static_cast<Word>(op(a, load(src, src_pos + k - n, src_pos + k))), n);
+      }
+    }
+    else
+    {
+      for (long long k = 0; k < len; k += W)
+      {
+        int n = static_cast<int>(len - k < W ? len - k : W);
+        Word a = load(static_cast<const Word *>(dst), dst_pos + k, dst_pos + len);
+        store(dst, dst_pos + k, static_cast<Word>(op(a, load(src, src_pos + k, src_pos + len))), n);
+      }
+    }
+  }
+
+  // swaps len bits starting at a with len bits starting at b a word at a time, the ranges must not overlap
+  template <typename Word>
+  inline void swap_ranges(Word *words, long long a, long long b, long long len)
+  {
+    const int W = bits<Word>();
+
+    for (long long k = 0; k < len; k += W)
+    {
+      int n = static_cast<int>(len - k < W ? len - k : W);
+      Word x = load(static_cast<const Word *>(words), a + k, a + len);
+      Word y = load(static_cast<const Word *>(words), b + k, b + len);
+      store(words, a + k, y, n);
+      store(words, b + k, x, n);
+    }
+  }
+
+  // rotates the bits [first, last) towards first by k, 0 <= k <= last - first, uses a constant amount of extra memory
+  template <typename Word>
+  inline void rotate(Word *words, long long first, long long last, long long k)
+  {
+    const int buffer_words = 16; // the shorter block is moved through a fixed buffer once it fits into it
+    const long long buffer_bits = static_cast<long long>(buffer_words) * bits<Word>();
+    Word buffer[buffer_words]{};
+
+    long long i = k;            // the length of the block moving to the end
+    long long j = last - first - k; // the length of the block moving to the front
+    long long p = first + k;    // the border between the blocks
+
+    if (i == 0 || j == 0)
+      return;
+
+    while (true)
+    {
+      if (i <= buffer_bits) // the front block is saved, the back block is moved to the front, the saved block is placed after it
+      {
+        copy(buffer, 0, static_cast<const Word *>(words), p - i, i);
+        copy(words, p - i, static_cast<const Word *>(words), p, j);
+        copy(words, p - i + j, static_cast<const Word *>(buffer), 0, i);
+        return;
+      }
+
+      if (j <= buffer_bits) // the back block is saved, the front block is moved to the back, the saved block is placed before it
+      {
+        copy(buffer, 0, static_cast<const Word *>(words), p, j);
+        copy(words, p - i + j, static_cast<const Word *>(words), p - i, i);
+        copy(words, p - i, static_cast<const Word *>(buffer), 0, j);
+        return;
+      }
+
+      if (i == j)
+      {
+        swap_ranges(words, p - i, p, i);
+        return;
+      }
+
+      if (i > j) // the last j bits of the front block are swapped with the back block and reach their final place
+      {
+        swap_ranges(words, p - j, p, j);
+        p -= j;
+        i -= j;
+      }
+      else // the front block is swapped with the first i bits of the back block, which reach their final place
+      {
+        swap_ranges(words, p - i, p, i);
+        p += i;
+        j -= i;
+      }
+    }
+  }
+
+  // writes the bits of src shifted towards index 0 by n to dst, the freed cells are filled with false, dst may be equal to src
+  template <typename Word>
+  inline void shift_down(Word *dst, const Word *src, long long words, long long n)
+  {
+    const int W = bits<Word>();
+    long long shift = n / W;
+    int offset = static_cast<int>(n % W);
+
+    for (long long i = 0; i < words; ++i) // ascending order reads every source word before it is overwritten
+    {
+      Word w = 0;
+
+      if (i + shift < words)
+      {
+        w = static_cast<Word>(src[i + shift] >> offset);
+
+        if (offset != 0 && i + shift + 1 < words)
+          w |= static_cast<Word>(src[i + shift + 1] << (W - offset)); // funnel shift with the next word
+      }
+
+      dst[i] = w;
+    }
+  }
+
+  // writes the bits of src shifted away from index 0 by n to dst, the freed cells are filled with false, dst may be equal to src
+  template <typename Word>
+  inline void shift_up(Word *dst, const Word *src, long long words, long long n)
+  {
+    const int W = bits<Word>();
+    long long shift = n / W;
+    int offset = static_cast<int>(n % W);
+
+    for (long long i = words - 1; i >= 0; --i) // descending order reads every source word before it is overwritten
+    {
+      Word w = 0;
+
+      if (i - shift >= 0)
+      {
+        w = static_cast<Word>(src[i - shift] << offset);
+
+        if (offset != 0 && i - shift - 1 >= 0)
+          w |= static_cast<Word>(src[i - shift - 1] >> (W - offset)); // funnel shift with the previous word
+      }
+
+      dst[i] = w;
+    }
+  }
+
+  // combines every word of dst with the word of src shifted towards index 0 by n, dst[i] = op(dst[i], shifted[i]), dst may be equal to src
+  template <typename Word, typename Op>
+  inline void shift_down_combine(Word *dst, const Word *src, long long words, long long n, Op op)
+  {
+    const int W = bits<Word>();
+    long long shift = n / W;
+    int offset = static_cast<int>(n % W);
+
+    for (long long i = 0; i < words; ++i) // ascending order reads every source word before it is overwritten
+    {
+      Word w = 0;
+
+      if (i + shift < words)
+      {
+        w = static_cast<Word>(src[i + shift] >> offset);
+
+        if (offset != 0 && i + shift + 1 < words)
+          w |= static_cast<Word>(src[i + shift + 1] << (W - offset)); // funnel shift with the next word
+      }
+
+      dst[i] = op(dst[i], w);
+    }
+  }
+
+  // combines every word of dst with the word of src shifted away from index 0 by n, dst[i] = op(dst[i], shifted[i]), dst may be equal to src
+  template <typename Word, typename Op>
+  inline void shift_up_combine(Word *dst, const Word *src, long long words, long long n, Op op)
+  {
+    const int W = bits<Word>();
+    long long shift = n / W;
+    int offset = static_cast<int>(n % W);
+
+    for (long long i = words - 1; i >= 0; --i) // descending order reads every source word before it is overwritten
+    {
+      Word w = 0;
+
+      if (i - shift >= 0)
+      {
+        w = static_cast<Word>(src[i - shift] << offset);
+
+        if (offset != 0 && i - shift - 1 >= 0)
+          w |= static_cast<Word>(src[i - shift - 1] >> (W - offset)); // funnel shift with the previous word
+      }
+
+      dst[i] = op(dst[i], w);
+    }
+  }
+
+  // transposes the W x W bit block in place, the bit c of the word r moves to the bit r of the word c, uses log2(W) rounds of masked swaps
+  template <typename Word>
+  inline void transpose(Word *block)
+  {
+    const int W = bits<Word>();
+    int j = W / 2;
+    Word m = low_mask<Word>(j); // the columns whose bit j is 0
+
+    for (; j != 0; j >>= 1, m = static_cast<Word>(m ^ (m << j)))
+    {
+      for (int k = 0; k < W; k = (k + j + 1) & ~j) // the rows whose bit j is 0
+      {
+        Word t = static_cast<Word>(((block[k] >> j) ^ block[k + j]) & m); // the cells (k, c + j) and (k + j, c) that differ
+        block[k] = static_cast<Word>(block[k] ^ (t << j));
+        block[k + j] = static_cast<Word>(block[k + j] ^ t);
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,348 @@
+#include "bitmatrix.hpp"
+#include "bitarray_words.hpp"
+
+#include <climits>
+
+const int BitMatrix::dim;
+const int BitMatrix::table_bits;
+
+// returns the pointer to the words of the r-index row
+unsigned long *BitMatrix::row_words(int r)
+{
+    return this->bits.data() + static_cast<long long>(r) * this->stride;
+}
+
+// returns the pointer to the words of the r-index row
+const unsigned long *BitMatrix::row_words(int r) const
+{
+    return this->bits.data() + static_cast<long long>(r) * this->stride;
+}
+
+// checks the row and column indices
+void BitMatrix::check_cell(int r, int c) const
+{
+    if (r < 0 || r >= this->num_rows || c < 0 || c >= this->num_cols) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+}
+
+// brings the matrix to row echelon form by XOR of rows, the pivots are also cleared above when reduced is true, returns the rank
+int BitMatrix::echelon(bool reduced)
+{
+    int rank = 0;
+
+    for (int c = 0; c < this->num_cols && rank < this->num_rows; ++c)
+    {
+        int w = c / dim;
+        unsigned long mask = 1UL << (c % dim);
+        int pivot = rank;
+
+        while (pivot < this->num_rows && ((*this).row_words(pivot)[w] & mask) == 0UL)
+            ++pivot;
+
+        if (pivot == this->num_rows) // the column has no pivot
+            continue;
+
+        if (pivot != rank)
+            std::swap_ranges((*this).row_words(pivot), (*this).row_words(pivot) + this->stride, (*this).row_words(rank));
+
+        const unsigned long *p = (*this).row_words(rank);
+
+        for (int i = reduced ? 0 : rank + 1; i < this->num_rows; ++i)
+        {
+            unsigned long *row = (*this).row_words(i);
+
+            if (i != rank && (row[w] & mask) != 0UL)
+            {
+                for (int x = w; x < this->stride; ++x)
+                    row[x] ^= p[x]; // the words before the pivot word are false in the pivot row and need no XOR
+            }
+        }
+
+        ++rank;
+    }
+
+    return rank;
+}
+
+// writes op-sum of the products of a and b to c, the rows of b are combined table_bits at a time into a lookup table of all their op-sums
+template <typename Op>
+void BitMatrix::multiply_table(const BitMatrix &a, const BitMatrix &b, BitMatrix &c, Op op)
+{
+    const int stride = b.stride;
+    std::vector<unsigned long> table((static_cast<std::size_t>(1) << table_bits) * stride); // the entry 0 stays false
+
+    for (int g = 0; g < a.num_cols; g += table_bits)
+    {
+        int n = std::min(table_bits, a.num_cols - g);
+
+        for (int i = 1; i < (1 << n); ++i)
+        {
+            unsigned long *entry = table.data() + static_cast<std::size_t>(i) * stride;
+            const unsigned long *prev = table.data() + static_cast<std::size_t>(i & (i - 1)) * stride; // the entry without the lowest row
+            const unsigned long *row = b.row_words(g + bitarray_words::ctz(static_cast<unsigned long long>(i)));
+
+            for (int x = 0; x < stride; ++x)
+                entry[x] = op(prev[x], row[x]); // every entry costs one pass over a row of b
+        }
+
+        for (int r = 0; r < a.num_rows; ++r)
+        {
+            unsigned long index = (a.row_words(r)[g / dim] >> (g % dim)) & bitarray_words::low_mask<unsigned long>(n); // table_bits divides dim, so the group never crosses a word boundary
+
+            if (index == 0UL)
+                continue;
+
+            unsigned long *dst = c.row_words(r);
+            const unsigned long *entry = table.data() + index * stride;
+
+            for (int x = 0; x < stride; ++x)
+                dst[x] = op(dst[x], entry[x]);
+        }
+    }
+}
+
+// default constructor, creates an empty matrix
+BitMatrix::BitMatrix() {}
+
+// creates a matrix of num_rows x num_cols false bits, works only when the rows padded to whole words hold at most INT_MAX bits
+BitMatrix::BitMatrix(int num_rows, int num_cols) : num_rows(num_rows), num_cols(num_cols)
+{
+    if (num_rows < 0 || num_cols < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: arguments num_rows and num_cols expect values >= 0");
+    }
+
+    this->stride = static_cast<int>((static_cast<long long>(num_cols) + dim - 1) / dim);
+
+    long long num_bits = static_cast<long long>(num_rows) * this->stride * dim; // the rows are padded to whole words, the padding stays false
+
+    if (num_bits > INT_MAX) // the size check, the bits are held by one BitArray
+    {
+        throw std::invalid_argument("Error: matrix is too large");
+    }
+
+    if (num_bits > 0)
+        this->bits = BitArray(static_cast<int>(num_bits));
+}
+
+// returns the n x n identity matrix
+BitMatrix BitMatrix::identity(int n)
+{
+    BitMatrix new_object(n, n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        new_object.row_words(i)[i / dim] |= 1UL << (i % dim);
+    }
+
+    return new_object;
+}
+
+// returns the number of rows
+int BitMatrix::rows() const
+{
+    return this->num_rows;
+}
+
+// returns the number of columns
+int BitMatrix::cols() const
+{
+    return this->num_cols;
+}
+
+// returns true if the matrix has no bits
+bool BitMatrix::empty() const
+{
+    return this->bits.empty();
+}
+
+// returns the value of the bit in the r-index row and the c-index column
+bool BitMatrix::get(int r, int c) const
+{
+    (*this).check_cell(r, c);
+
+    return ((*this).row_words(r)[c / dim] >> (c % dim)) & 1UL;
+}
+
+// sets the bit in the r-index row and the c-index column to val
+BitMatrix &BitMatrix::set(int r, int c, bool val)
+{
+    (*this).check_cell(r, c);
+
+    if (val)
+        (*this).row_words(r)[c / dim] |= 1UL << (c % dim);
+    else
+        (*this).row_words(r)[c / dim] &= ~(1UL << (c % dim));
+
+    return *this;
+}
+
+// sets the bit in the r-index row and the c-index column to the value false
+BitMatrix &BitMatrix::reset(int r, int c)
+{
+    return (*this).set(r, c, false);
+}
+
+// returns a mutable span of the r-index row, it stays valid while the matrix is alive
+BitArraySpan BitMatrix::row(int r)
+{
+    if (r < 0 || r >= this->num_rows) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    return BitArraySpan((*this).row_words(r), 0, this->num_cols);
+}
+
+// returns a read-only view of the r-index row, it stays valid while the matrix is alive
+BitArrayView BitMatrix::row(int r) const
+{
+    if (r < 0 || r >= this->num_rows) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    return BitArrayView((*this).row_words(r), 0, this->num_cols);
+}
+
+// swaps the r1-index and r2-index rows
+BitMatrix &BitMatrix::swap_rows(int r1, int r2)
+{
+    if (r1 < 0 || r1 >= this->num_rows || r2 < 0 || r2 >= this->num_rows) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    if (r1 != r2)
+        std::swap_ranges((*this).row_words(r1), (*this).row_words(r1) + this->stride, (*this).row_words(r2));
+
+    return *this;
+}
+
+// returns the transposed matrix, the bits are moved in dim x dim blocks
+BitMatrix BitMatrix::transpose() const
+{
+    BitMatrix new_object(this->num_cols, this->num_rows);
+    unsigned long block[dim];
+
+    for (int bi = 0; bi < new_object.stride; ++bi) // the word bi of a row of the result holds the rows [bi * dim, bi * dim + dim)
+    {
+        for (int bj = 0; bj < this->stride; ++bj)
+        {
+            for (int k = 0; k < dim; ++k)
+            {
+                int r = bi * dim + k;
+                block[k] = r < this->num_rows ? (*this).row_words(r)[bj] : 0UL; // the missing rows of the last block are read as false
+            }
+
+            bitarray_words::transpose(block);
+
+            for (int k = 0; k < dim && bj * dim + k < this->num_cols; ++k)
+            {
+                new_object.row_words(bj * dim + k)[bi] = block[k];
+            }
+        }
+    }
+
+    return new_object;
+}
+
+// product over GF(2) (AND as multiplication, XOR as addition), works only when cols() == b.rows(), uses the Method of Four Russians
+BitMatrix BitMatrix::multiply(const BitMatrix &b) const
+{
+    if (this->num_cols != b.num_rows) // the matrix sizes check
+    {
+        throw std::runtime_error("Error: matrix sizes do not match");
+    }
+
+    BitMatrix new_object(this->num_rows, b.num_cols);
+
+    multiply_table(*this, b, new_object, [](unsigned long x, unsigned long y) { return x ^ y; });
+
+    return new_object;
+}
+
+// boolean product (AND as multiplication, OR as addition), works only when cols() == b.rows(), uses the Method of Four Russians
+BitMatrix BitMatrix::boolean_multiply(const BitMatrix &b) const
+{
+    if (this->num_cols != b.num_rows) // the matrix sizes check
+    {
+        throw std::runtime_error("Error: matrix sizes do not match");
+    }
+
+    BitMatrix new_object(this->num_rows, b.num_cols);
+
+    multiply_table(*this, b, new_object, [](unsigned long x, unsigned long y) { return x | y; });
+
+    return new_object;
+}
+
+// brings the matrix to reduced row echelon form over GF(2), returns the rank
+int BitMatrix::eliminate()
+{
+    return (*this).echelon(true);
+}
+
+// returns the rank of the matrix over GF(2)
+int BitMatrix::rank() const
+{
+    BitMatrix copy(*this);
+
+    return copy.echelon(false);
+}
+
+// addition over GF(2), works only when matrix sizes match, result is assigned to the object
+BitMatrix &BitMatrix::operator^=(const BitMatrix &b)
+{
+    if (this->num_rows != b.num_rows || this->num_cols != b.num_cols) // the matrix sizes check
+    {
+        throw std::runtime_error("Error: matrix sizes do not match");
+    }
+
+    if (!(*this).empty())
+        this->bits ^= b.bits; // the padding of both matrices is false and stays false
+
+    return *this;
+}
+
+// returns the matrix as a string, one line per row
+std::string BitMatrix::to_string() const
+{
+    std::string str("");
+
+    for (int r = 0; r < this->num_rows; ++r)
+    {
+        if (r > 0)
+            str.append("\n");
+
+        for (int c = 0; c < this->num_cols; ++c)
+            str.append((*this).get(r, c) ? "1" : "0");
+    }
+
+    return str;
+}
+
+// equality operator, return true if the matrices are the same, works only when matrix sizes match
+bool operator==(const BitMatrix &a, const BitMatrix &b)
+{
+    if (a.rows() != b.rows() || a.cols() != b.cols()) // the matrix sizes check
+    {
+        throw std::runtime_error("Error: matrix sizes do not match");
+    }
+
+    for (int r = 0; r < a.rows(); ++r)
+    {
+        if (a.row(r) != b.row(r))
+            return false;
+    }
+
+    return true;
+}
+
+// inequality operator, return true if the matrices are not the same, works only when matrix sizes match
+bool operator!=(const BitMatrix &a, const BitMatrix &b)
+{
+    return !(a == b);
+}
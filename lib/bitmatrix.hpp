@@ -0,0 +1,90 @@
+#ifndef BITMATRIX_HPP
+#define BITMATRIX_HPP
+
+#include "bitarray.hpp"
+#include "bitarray_view.hpp"
+
+// matrix of bits over GF(2) or the boolean semiring, the rows are stored back to back in one BitArray and every row starts at a word boundary
+class BitMatrix
+{
+private:
+  BitArray bits;
+  int num_rows{0};
+  int num_cols{0};
+  int stride{0}; // the number of words per row
+
+  // returns the pointer to the words of the r-index row
+  unsigned long *row_words(int r);
+  // returns the pointer to the words of the r-index row
+  const unsigned long *row_words(int r) const;
+
+  // checks the row and column indices
+  void check_cell(int r, int c) const;
+
+  // brings the matrix to row echelon form by XOR of rows, the pivots are also cleared above when reduced is true, returns the rank
+  int echelon(bool reduced);
+
+  // writes op-sum of the products of a and b to c, the rows of b are combined table_bits at a time into a lookup table of all their op-sums
+  template <typename Op>
+  static void multiply_table(const BitMatrix &a, const BitMatrix &b, BitMatrix &c, Op op);
+
+public:
+  static const int dim{sizeof(unsigned long) * 8};
+  // number of rows of b combined into one lookup table by the multiplications (Method of Four Russians)
+  static const int table_bits{8};
+
+  // default constructor, creates an empty matrix
+  BitMatrix();
+  // creates a matrix of num_rows x num_cols false bits, works only when the rows padded to whole words hold at most INT_MAX bits
+  BitMatrix(int num_rows, int num_cols);
+
+  // returns the n x n identity matrix
+  static BitMatrix identity(int n);
+
+  // returns the number of rows
+  int rows() const;
+  // returns the number of columns
+  int cols() const;
+  // returns true if the matrix has no bits
+  bool empty() const;
+
+  // returns the value of the bit in the r-index row and the c-index column
+  bool get(int r, int c) const;
+  // sets the bit in the r-index row and the c-index column to val
+  BitMatrix &set(int r, int c, bool val = true);
+  // sets the bit in the r-index row and the c-index column to the value false
+  BitMatrix &reset(int r, int c);
+
+  // returns a mutable span of the r-index row, it stays valid while the matrix is alive
+  BitArraySpan row(int r);
+  // returns a read-only view of the r-index row, it stays valid while the matrix is alive
+  BitArrayView row(int r) const;
+  // swaps the r1-index and r2-index rows
+  BitMatrix &swap_rows(int r1, int r2);
+
+  // returns the transposed matrix, the bits are moved in dim x dim blocks
+  BitMatrix transpose() const;
+
+  // product over GF(2) (AND as multiplication, XOR as addition), works only when cols() == b.rows(), uses the Method of Four Russians
+  BitMatrix multiply(const BitMatrix &b) const;
+  // boolean product (AND as multiplication, OR as addition), works only when cols() == b.rows(), uses the Method of Four Russians
+  BitMatrix boolean_multiply(const BitMatrix &b) const;
+
+  // brings the matrix to reduced row echelon form over GF(2), returns the rank
+  int eliminate();
+  // returns the rank of the matrix over GF(2)
+  int rank() const;
+
+  // addition over GF(2), works only when matrix sizes match, result is assigned to the object
+  BitMatrix &operator^=(const BitMatrix &b);
+
+  // returns the matrix as a string, one line per row
+  std::string to_string() const;
+};
+
+// equality operator, return true if the matrices are the same, works only when matrix sizes match
+bool operator==(const BitMatrix &a, const BitMatrix &b);
+// inequality operator, return true if the matrices are not the same, works only when matrix sizes match
+bool operator!=(const BitMatrix &a, const BitMatrix &b);
+
+#endif
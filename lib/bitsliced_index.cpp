@@ -0,0 +1,329 @@
+#include "bitsliced_index.hpp"
+#include "bitarray_words.hpp"
+
+namespace
+{
+    // number of bits in an unsigned long cell
+    const int word_bits = sizeof(unsigned long) * 8;
+
+    // writes the len lowest bits of the 64-bit word w to the words starting at the pos-index bit, 0 < len <= 64
+    void store64(unsigned long *words, long long pos, std::uint64_t w, int len)
+    {
+        for (int part = 0; part < len; part += word_bits) // one store for 64-bit cells, two for 32-bit ones
+        {
+            bitarray_words::store(words, pos + part, static_cast<unsigned long>(w >> part), std::min(word_bits, len - part));
+        }
+    }
+}
+
+// writes the rows whose values are less than c to lt, equal to c to eq and greater than c to gt, lt and gt are skipped when they are null
+void BitSlicedIndex::compare(std::uint64_t c, BitArray *lt, BitArray &eq, BitArray *gt) const
+{
+    eq = this->all;
+
+    if (lt != nullptr)
+        *lt = BitArray(this->num_rows);
+
+    if (gt != nullptr)
+        *gt = BitArray(this->num_rows);
+
+    if (this->num_rows == 0)
+        return;
+
+    const int num_slices = static_cast<int>(this->slices.size());
+
+    if (num_slices < 64 && (c >> num_slices) != 0) // c is above every value
+    {
+        if (lt != nullptr)
+            *lt = this->all;
+
+        eq.reset();
+        return;
+    }
+
+    const int words = (this->num_rows + word_bits - 1) / word_bits;
+    unsigned long *e = eq.data();
+    unsigned long *l = lt != nullptr ? lt->data() : nullptr;
+    unsigned long *g = gt != nullptr ? gt->data() : nullptr;
+
+    for (int j = num_slices - 1; j >= 0; --j) // the slices are scanned from the highest bit, the rows still equal to c decide at the first differing bit
+    {
+        const unsigned long *s = this->slices[j].data();
+
+        if ((c >> j) & 1)
+        {
+            if (l != nullptr)
+            {
+                for (int i = 0; i < words; ++i)
+                    l[i] |= e[i] & ~s[i]; // the rows equal so far with a false bit j are less than c
+            }
+
+            for (int i = 0; i < words; ++i)
+                e[i] &= s[i];
+        }
+        else
+        {
+            if (g != nullptr)
+            {
+                for (int i = 0; i < words; ++i)
+                    g[i] |= e[i] & s[i]; // the rows equal so far with a true bit j are greater than c
+            }
+
+            for (int i = 0; i < words; ++i)
+                e[i] &= ~s[i];
+        }
+    }
+}
+
+// default constructor, creates an empty index
+BitSlicedIndex::BitSlicedIndex() {}
+
+// creates an index of num_rows values, the value of the k-index row is values[k], the number of slices is the bit width of the largest value
+BitSlicedIndex::BitSlicedIndex(const std::uint64_t *values, int num_rows) : num_rows(num_rows)
+{
+    if (num_rows < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument num_rows expects value >= 0");
+    }
+
+    if (values == nullptr && num_rows > 0) // the value array check
+    {
+        throw std::invalid_argument("Error: value array is null");
+    }
+
+    std::uint64_t max = 0;
+
+    for (int k = 0; k < num_rows; ++k)
+        max |= values[k];
+
+    int num_slices = max == 0 ? 0 : bitarray_words::msb(max) + 1;
+
+    this->all = BitArray(num_rows);
+
+    if (num_rows > 0)
+        this->all.set();
+
+    this->slices.reserve(num_slices);
+
+    for (int j = 0; j < num_slices; ++j)
+        this->slices.emplace_back(num_rows);
+
+    std::uint64_t block[64];
+
+    for (int r = 0; r < num_rows; r += 64) // every 64 rows are turned into 64 slice words by one block transpose
+    {
+        int n = std::min(64, num_rows - r);
+
+        for (int k = 0; k < 64; ++k)
+            block[k] = k < n ? values[r + k] : 0;
+
+        bitarray_words::transpose(block);
+
+        for (int j = 0; j < num_slices; ++j)
+            store64(this->slices[j].data(), r, block[j], n);
+    }
+}
+
+// returns the number of rows
+int BitSlicedIndex::size() const
+{
+    return this->num_rows;
+}
+
+// returns true if the index has no rows
+bool BitSlicedIndex::empty() const
+{
+    return this->num_rows == 0;
+}
+
+// returns the number of slices
+int BitSlicedIndex::num_slices() const
+{
+    return static_cast<int>(this->slices.size());
+}
+
+// returns the j-index slice, the bit k is the bit j of the value of the k-index row
+const BitArray &BitSlicedIndex::slice(int j) const
+{
+    if (j < 0 || j >= static_cast<int>(this->slices.size())) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    return this->slices[j];
+}
+
+// returns the value of the k-index row
+std::uint64_t BitSlicedIndex::value(int k) const
+{
+    if (k < 0 || k >= this->num_rows) // the index validitation check
+    {
+        throw std::out_of_range("Error: index is out of range");
+    }
+
+    std::uint64_t v = 0;
+
+    for (std::size_t j = 0; j < this->slices.size(); ++j)
+        v |= static_cast<std::uint64_t>((this->slices[j].data()[k / word_bits] >> (k % word_bits)) & 1UL) << j;
+
+    return v;
+}
+
+// returns the rows whose values are equal to v
+BitArray BitSlicedIndex::equal(std::uint64_t v) const
+{
+    BitArray eq;
+
+    (*this).compare(v, nullptr, eq, nullptr);
+
+    return eq;
+}
+
+// returns the rows whose values are less than v
+BitArray BitSlicedIndex::less(std::uint64_t v) const
+{
+    BitArray lt, eq;
+
+    (*this).compare(v, &lt, eq, nullptr);
+
+    return lt;
+}
+
+// returns the rows whose values are less than or equal to v
+BitArray BitSlicedIndex::less_equal(std::uint64_t v) const
+{
+    BitArray lt, eq;
+
+    (*this).compare(v, &lt, eq, nullptr);
+
+    if (this->num_rows > 0)
+        lt |= eq;
+
+    return lt;
+}
+
+// returns the rows whose values are greater than v
+BitArray BitSlicedIndex::greater(std::uint64_t v) const
+{
+    BitArray gt, eq;
+
+    (*this).compare(v, nullptr, eq, &gt);
+
+    return gt;
+}
+
+// returns the rows whose values are greater than or equal to v
+BitArray BitSlicedIndex::greater_equal(std::uint64_t v) const
+{
+    BitArray gt, eq;
+
+    (*this).compare(v, nullptr, eq, &gt);
+
+    if (this->num_rows > 0)
+        gt |= eq;
+
+    return gt;
+}
+
+// returns the rows whose values are in [lo, hi]
+BitArray BitSlicedIndex::between(std::uint64_t lo, std::uint64_t hi) const
+{
+    if (lo > hi) // an empty range
+        return BitArray(this->num_rows);
+
+    BitArray rows = (*this).greater_equal(lo);
+
+    if (this->num_rows > 0)
+        rows &= (*this).less_equal(hi);
+
+    return rows;
+}
+
+// returns k rows with the largest values, the ties at the k-th value are taken from the lowest rows
+BitArray BitSlicedIndex::top_k(int k) const
+{
+    if (k < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument k expects value >= 0");
+    }
+
+    if (k >= this->num_rows)
+        return this->all;
+
+    const int words = (this->num_rows + word_bits - 1) / word_bits;
+    BitArray result(this->num_rows); // the rows certainly among the top k
+    BitArray candidates(this->all);  // the rows whose values equal the top k boundary on the slices seen so far
+    unsigned long *g = result.data();
+    unsigned long *e = candidates.data();
+    long long taken = 0;
+
+    for (int j = static_cast<int>(this->slices.size()) - 1; j >= 0 && taken < k; --j)
+    {
+        const unsigned long *s = this->slices[j].data();
+        long long n = taken;
+
+        for (int i = 0; i < words; ++i)
+            n += bitarray_words::popcount(e[i] & s[i]); // the rows taken so far plus the candidates with a true bit j
+
+        if (n > k) // too many rows have a true bit j, the boundary has it too
+        {
+            for (int i = 0; i < words; ++i)
+                e[i] &= s[i];
+        }
+        else // all candidates with a true bit j are taken, the boundary has a false bit j
+        {
+            for (int i = 0; i < words; ++i)
+            {
+                g[i] |= e[i] & s[i];
+                e[i] &= ~s[i];
+            }
+
+            taken = n;
+        }
+    }
+
+    for (int i = 0; i < words && taken < k; ++i) // the remaining places are filled with the lowest tied rows
+    {
+        for (unsigned long w = e[i]; w != 0UL && taken < k; w &= w - 1, ++taken)
+            g[i] |= w & (~w + 1); // the lowest true bit of w
+    }
+
+    return result;
+}
+
+// returns the sum of the values of all rows modulo 2^64
+std::uint64_t BitSlicedIndex::sum() const
+{
+    std::uint64_t total = 0;
+
+    for (std::size_t j = 0; j < this->slices.size(); ++j)
+        total += static_cast<std::uint64_t>(this->slices[j].count()) << j; // every true bit of the slice j adds 2^j
+
+    return total;
+}
+
+// returns the sum of the values of the rows in the row set modulo 2^64, works only when the row set size matches the index size
+std::uint64_t BitSlicedIndex::sum(const BitArray &rows) const
+{
+    if (rows.size() != this->num_rows) // the sizes check
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    const int words = (this->num_rows + word_bits - 1) / word_bits;
+    const unsigned long *r = rows.data();
+    std::uint64_t total = 0;
+
+    for (std::size_t j = 0; j < this->slices.size(); ++j)
+    {
+        const unsigned long *s = this->slices[j].data();
+        std::uint64_t count = 0;
+
+        for (int i = 0; i < words; ++i)
+            count += bitarray_words::popcount(s[i] & r[i]); // the rows of the set are counted without a temporary array
+
+        total += count << j;
+    }
+
+    return total;
+}
@@ -0,0 +1,56 @@
+#ifndef BITSLICED_INDEX_HPP
+#define BITSLICED_INDEX_HPP
+
+#include "bitarray.hpp"
+
+// bit-sliced index over a column of unsigned integers, the slice j holds the bit j of the value of every row, so the predicates are evaluated with word-level operations across the slices
+class BitSlicedIndex
+{
+private:
+  std::vector<BitArray> slices;
+  BitArray all; // the true bit of every row
+  int num_rows{0};
+
+  // writes the rows whose values are less than c to lt, equal to c to eq and greater than c to gt, lt and gt are skipped when they are null
+  void compare(std::uint64_t c, BitArray *lt, BitArray &eq, BitArray *gt) const;
+
+public:
+  // default constructor, creates an empty index
+  BitSlicedIndex();
+  // creates an index of num_rows values, the value of the k-index row is values[k], the number of slices is the bit width of the largest value
+  BitSlicedIndex(const std::uint64_t *values, int num_rows);
+
+  // returns the number of rows
+  int size() const;
+  // returns true if the index has no rows
+  bool empty() const;
+  // returns the number of slices
+  int num_slices() const;
+  // returns the j-index slice, the bit k is the bit j of the value of the k-index row
+  const BitArray &slice(int j) const;
+  // returns the value of the k-index row
+  std::uint64_t value(int k) const;
+
+  // returns the rows whose values are equal to v
+  BitArray equal(std::uint64_t v) const;
+  // returns the rows whose values are less than v
+  BitArray less(std::uint64_t v) const;
+  // returns the rows whose values are less than or equal to v
+  BitArray less_equal(std::uint64_t v) const;
+  // returns the rows whose values are greater than v
+  BitArray greater(std::uint64_t v) const;
+  // returns the rows whose values are greater than or equal to v
+  BitArray greater_equal(std::uint64_t v) const;
+  // returns the rows whose values are in [lo, hi]
+  BitArray between(std::uint64_t lo, std::uint64_t hi) const;
+
+  // returns k rows with the largest values, the ties at the k-th value are taken from the lowest rows
+  BitArray top_k(int k) const;
+
+  // returns the sum of the values of all rows modulo 2^64
+  std::uint64_t sum() const;
+  // returns the sum of the values of the rows in the row set modulo 2^64, works only when the row set size matches the index size
+  std::uint64_t sum(const BitArray &rows) const;
+};
+
+#endif
@@ -0,0 +1,264 @@
+#include "bloomfilter.hpp"
+#include "bitarray_words.hpp"
+
+#include <climits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+const int BloomFilter::block_bits;
+const int BloomFilter::num_hashes;
+
+namespace
+{
+    // odd multipliers choosing the bit of each lane, one per lane
+    const std::uint32_t salts[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    // number of bits in an unsigned long cell of the storage
+    const int word_bits = sizeof(unsigned long) * 8;
+
+    // the distance in keys at which the blocks of batched keys are prefetched
+    const int prefetch_distance = 8;
+
+    // spreads the bits of the key over the whole hash, so that sequential keys land in unrelated blocks
+    std::uint64_t mix(std::uint64_t key)
+    {
+        key ^= key >> 30;
+        key *= 0xBF58476D1CE4E5B9ULL;
+        key ^= key >> 27;
+        key *= 0x94D049BB133111EBULL;
+        key ^= key >> 31;
+
+        return key;
+    }
+
+#if defined(__AVX2__)
+    // returns the 8 lane masks of the hashed key in one register
+    __m256i lane_vector(std::uint64_t hash)
+    {
+        const __m256i salt = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(salts));
+
+        __m256i bit = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(hash)), salt), 27); // the 5 highest bits of each product choose the bit of the lane
+
+        return _mm256_sllv_epi32(_mm256_set1_epi32(1), bit);
+    }
+
+    // the vector kernels read the words of a block as 8 32-bit lanes, which matches the word layout on little-endian hosts with 64-bit words
+    const bool vector_layout = sizeof(unsigned long) == 8;
+#endif
+}
+
+// returns the index of the block of the hashed key
+int BloomFilter::block_of(std::uint64_t hash) const
+{
+    return static_cast<int>(((hash >> 32) * static_cast<std::uint64_t>(this->num_blocks)) >> 32); // the high half of the hash is mapped onto the blocks without a division
+}
+
+// returns the 8 lane masks of the hashed key, the lane i holds the bits [32i, 32i + 32) of a block
+void BloomFilter::lane_masks(std::uint64_t hash, std::uint32_t *masks)
+{
+    std::uint32_t x = static_cast<std::uint32_t>(hash);
+
+    for (int i = 0; i < num_hashes; ++i)
+    {
+        masks[i] = 1U << ((x * salts[i]) >> 27); // the 5 highest bits of each product choose the bit of the lane
+    }
+}
+
+// default constructor, creates an empty filter
+BloomFilter::BloomFilter() {}
+
+// creates a filter of num_bits bits rounded up to whole blocks, about 10 bits per expected key give a 1% false positive rate
+BloomFilter::BloomFilter(int num_bits)
+{
+    if (num_bits <= 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument num_bits expects value > 0");
+    }
+
+    long long blocks = (static_cast<long long>(num_bits) + block_bits - 1) / block_bits; // rounded up in long long, a size near INT_MAX overflows int
+
+    if (blocks * block_bits > INT_MAX) // the size check, the bits are held by one BitArray
+    {
+        throw std::invalid_argument("Error: filter is too large");
+    }
+
+    this->num_blocks = static_cast<int>(blocks);
+    this->bits = BitArray(this->num_blocks * block_bits);
+}
+
+// creates a filter from its serialised bits, the size of bits must be a positive multiple of block_bits
+BloomFilter::BloomFilter(const BitArray &bits)
+{
+    if (bits.empty() || bits.size() % block_bits != 0) // the argument check
+    {
+        throw std::invalid_argument("Error: size of bits expects a positive multiple of the block size");
+    }
+
+    this->num_blocks = bits.size() / block_bits;
+    this->bits = bits;
+}
+
+// adds the key to the filter
+void BloomFilter::insert(std::uint64_t key)
+{
+    if ((*this).empty()) // the filter empty check
+    {
+        throw std::invalid_argument("Error: filter is empty");
+    }
+
+    std::uint64_t hash = mix(key);
+    unsigned long *block = this->bits.data() + static_cast<long long>((*this).block_of(hash)) * block_bits / word_bits;
+
+#if defined(__AVX2__)
+    if (vector_layout)
+    {
+        __m256i *lanes = reinterpret_cast<__m256i *>(block);
+
+        _mm256_storeu_si256(lanes, _mm256_or_si256(_mm256_loadu_si256(lanes), lane_vector(hash))); // the 8 bits are set with one load and one store
+        return;
+    }
+#endif
+
+    std::uint32_t masks[num_hashes];
+    lane_masks(hash, masks);
+
+    for (int i = 0; i < num_hashes; ++i)
+    {
+        int bit = 32 * i;
+
+        block[bit / word_bits] |= static_cast<unsigned long>(masks[i]) << (bit % word_bits); // the lane is a half or a whole unsigned long cell
+    }
+}
+
+// returns true if the key may have been added, false if it certainly was not
+bool BloomFilter::contains(std::uint64_t key) const
+{
+    if ((*this).empty()) // the filter empty check
+    {
+        throw std::invalid_argument("Error: filter is empty");
+    }
+
+    std::uint64_t hash = mix(key);
+    const unsigned long *block = this->bits.data() + static_cast<long long>((*this).block_of(hash)) * block_bits / word_bits;
+
+#if defined(__AVX2__)
+    if (vector_layout)
+    {
+        __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+
+        return _mm256_testc_si256(lanes, lane_vector(hash)) != 0; // all 8 bits are tested with one instruction
+    }
+#endif
+
+    std::uint32_t masks[num_hashes];
+    lane_masks(hash, masks);
+
+    for (int i = 0; i < num_hashes; ++i)
+    {
+        int bit = 32 * i;
+        unsigned long mask = static_cast<unsigned long>(masks[i]) << (bit % word_bits);
+
+        if ((block[bit / word_bits] & mask) == 0UL) // a single false bit proves that the key was not added
+            return false;
+    }
+
+    return true;
+}
+
+// adds num keys to the filter, the blocks of later keys are prefetched
+void BloomFilter::insert_many(const std::uint64_t *keys, int num)
+{
+    if (num < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument num expects value >= 0");
+    }
+
+    if ((*this).empty() && num > 0) // the filter empty check
+    {
+        throw std::invalid_argument("Error: filter is empty");
+    }
+
+    for (int i = 0; i < num; ++i)
+    {
+        if (i + prefetch_distance < num)
+        {
+            int block = (*this).block_of(mix(keys[i + prefetch_distance]));
+
+            bitarray_words::prefetch(this->bits.data() + static_cast<long long>(block) * block_bits / word_bits); // the block of a later key is requested ahead of its use
+        }
+
+        (*this).insert(keys[i]);
+    }
+}
+
+// writes to out for each of num keys whether it may have been added, the blocks of later keys are prefetched
+void BloomFilter::contains_many(const std::uint64_t *keys, int num, bool *out) const
+{
+    if (num < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument num expects value >= 0");
+    }
+
+    if ((*this).empty() && num > 0) // the filter empty check
+    {
+        throw std::invalid_argument("Error: filter is empty");
+    }
+
+    for (int i = 0; i < num; ++i)
+    {
+        if (i + prefetch_distance < num)
+        {
+            int block = (*this).block_of(mix(keys[i + prefetch_distance]));
+
+            bitarray_words::prefetch(this->bits.data() + static_cast<long long>(block) * block_bits / word_bits); // the block of a later key is requested ahead of its use
+        }
+
+        out[i] = (*this).contains(keys[i]);
+    }
+}
+
+// union with the filter b, works only when filter sizes match, result is assigned to the object
+BloomFilter &BloomFilter::operator|=(const BloomFilter &b)
+{
+    this->bits |= b.bits; // the word operation of BitArray checks the sizes
+
+    return *this;
+}
+
+// intersection with the filter b, works only when filter sizes match, result is assigned to the object
+BloomFilter &BloomFilter::operator&=(const BloomFilter &b)
+{
+    this->bits &= b.bits; // the word operation of BitArray checks the sizes
+
+    return *this;
+}
+
+// removes all keys from the filter
+void BloomFilter::clear()
+{
+    if (!(*this).empty())
+    {
+        this->bits.reset();
+    }
+}
+
+// returns the number of bits of the filter
+int BloomFilter::size() const
+{
+    return this->bits.size();
+}
+
+// returns true if the filter has no bits
+bool BloomFilter::empty() const
+{
+    return this->num_blocks == 0;
+}
+
+// returns the storage of the filter, its words are the serialised form of the filter
+const BitArray &BloomFilter::storage() const
+{
+    return this->bits;
+}
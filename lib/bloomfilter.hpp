@@ -0,0 +1,57 @@
+#ifndef BLOOMFILTER_HPP
+#define BLOOMFILTER_HPP
+
+#include "bitarray.hpp"
+
+// register-blocked Bloom filter backed by a BitArray, every key sets one bit in each of the 8 32-bit lanes of one 256-bit block, so a key touches a single cache line
+class BloomFilter
+{
+private:
+  BitArray bits;
+  int num_blocks{0};
+
+  // returns the index of the block of the hashed key
+  int block_of(std::uint64_t hash) const;
+  // returns the 8 lane masks of the hashed key, the lane i holds the bits [32i, 32i + 32) of a block
+  static void lane_masks(std::uint64_t hash, std::uint32_t *masks);
+
+public:
+  // number of bits in a block
+  static const int block_bits{256};
+  // number of bits set per key
+  static const int num_hashes{8};
+
+  // default constructor, creates an empty filter
+  BloomFilter();
+  // creates a filter of num_bits bits rounded up to whole blocks, about 10 bits per expected key give a 1% false positive rate
+  explicit BloomFilter(int num_bits);
+  // creates a filter from its serialised bits, the size of bits must be a positive multiple of block_bits
+  explicit BloomFilter(const BitArray &bits);
+
+  // adds the key to the filter
+  void insert(std::uint64_t key);
+  // returns true if the key may have been added, false if it certainly was not
+  bool contains(std::uint64_t key) const;
+
+  // adds num keys to the filter, the blocks of later keys are prefetched
+  void insert_many(const std::uint64_t *keys, int num);
+  // writes to out for each of num keys whether it may have been added, the blocks of later keys are prefetched
+  void contains_many(const std::uint64_t *keys, int num, bool *out) const;
+
+  // union with the filter b, works only when filter sizes match, result is assigned to the object
+  BloomFilter &operator|=(const BloomFilter &b);
+  // intersection with the filter b, works only when filter sizes match, result is assigned to the object
+  BloomFilter &operator&=(const BloomFilter &b);
+
+  // removes all keys from the filter
+  void clear();
+
+  // returns the number of bits of the filter
+  int size() const;
+  // returns true if the filter has no bits
+  bool empty() const;
+  // returns the storage of the filter, its words are the serialised form of the filter
+  const BitArray &storage() const;
+};
+
+#endif
@@ -0,0 +1,369 @@
+#include "hamming_index.hpp"
+#include "bitarray_words.hpp"
+
+#include <cmath>
+#include <thread>
+#include <unordered_set>
+
+#if defined(__LP64__) && ((defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // number of bits in an unsigned long cell
+    const int word_bits = sizeof(unsigned long) * 8;
+
+    // returns the number of bits in which the words a and b differ
+    int distance(const unsigned long *a, const unsigned long *b, int words)
+    {
+        int i = 0;
+        int total = 0;
+
+#if defined(__LP64__) && defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+        if (words >= 8) // the short codes are counted faster by the scalar popcount than by a vector and its reduction
+        {
+            __m512i sum = _mm512_setzero_si512();
+
+            for (; i + 8 <= words; i += 8) // vpopcntq counts 8 words per instruction
+                sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_xor_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i))));
+
+            if (i < words)
+            {
+                __mmask8 mask = static_cast<__mmask8>((1U << (words - i)) - 1); // the masked loads read no word after the code
+                sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_xor_si512(_mm512_maskz_loadu_epi64(mask, a + i), _mm512_maskz_loadu_epi64(mask, b + i))));
+                i = words;
+            }
+
+            total = static_cast<int>(_mm512_reduce_add_epi64(sum));
+        }
+#elif defined(__LP64__) && defined(__AVX2__)
+        if (words >= 8) // the short codes are counted faster by the scalar popcount than by a vector and its reduction
+        {
+            const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i low = _mm256_set1_epi8(0x0F);
+            __m256i sum = _mm256_setzero_si256();
+
+            for (; i + 4 <= words; i += 4) // the bits of every nibble are counted by a shuffle lookup, the bytes are summed by sad
+            {
+                __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+                __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(x, low)), _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(x, 4), low)));
+                sum = _mm256_add_epi64(sum, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+            }
+
+            total = static_cast<int>(_mm256_extract_epi64(sum, 0) + _mm256_extract_epi64(sum, 1) + _mm256_extract_epi64(sum, 2) + _mm256_extract_epi64(sum, 3));
+        }
+#endif
+
+        for (; i < words; ++i)
+            total += bitarray_words::popcount(a[i] ^ b[i]);
+
+        return total;
+    }
+
+    // returns true if the match a is nearer than b, the ties are broken by the lower id
+    bool nearer(const HammingMatch &a, const HammingMatch &b)
+    {
+        return a.distance != b.distance ? a.distance < b.distance : a.id < b.id;
+    }
+
+    // the k nearest matches seen so far in a max-heap, the root is the farthest of them
+    class TopK
+    {
+    private:
+        std::vector<HammingMatch> heap;
+        std::size_t k;
+
+    public:
+        explicit TopK(int k) : k(k)
+        {
+            this->heap.reserve(k);
+        }
+
+        // returns true if k matches are held
+        bool full() const
+        {
+            return this->heap.size() == this->k;
+        }
+
+        // returns the farthest held match, works only when full
+        const HammingMatch &farthest() const
+        {
+            return this->heap.front();
+        }
+
+        // offers the match, it replaces the farthest one if it is nearer
+        void offer(const HammingMatch &m)
+        {
+            if (!(*this).full())
+            {
+                this->heap.push_back(m);
+                std::push_heap(this->heap.begin(), this->heap.end(), nearer);
+            }
+            else if (nearer(m, this->heap.front()))
+            {
+                std::pop_heap(this->heap.begin(), this->heap.end(), nearer);
+                this->heap.back() = m;
+                std::push_heap(this->heap.begin(), this->heap.end(), nearer);
+            }
+        }
+
+        // returns the held matches sorted from the nearest
+        std::vector<HammingMatch> sorted()
+        {
+            std::sort_heap(this->heap.begin(), this->heap.end(), nearer);
+
+            return std::move(this->heap);
+        }
+    };
+
+    // offers every one of the num codes of stride words to top, W is the stride when it is known at compile time and 0 otherwise
+    template <int W>
+    void scan_codes(const unsigned long *words, int num, int stride, const unsigned long *query, TopK &top)
+    {
+        if (W > 0)
+            stride = W;
+
+        for (int id = 0; id < num; ++id, words += stride)
+        {
+            int d = distance(words, query, stride);
+
+            if (!top.full() || d < top.farthest().distance) // the codes are scanned by ascending id, so a tie never replaces a held match
+                top.offer({id, d});
+        }
+    }
+
+    // calls f with every value that differs from key in exactly radius of its len low bits
+    template <typename F>
+    void for_each_neighbour(std::uint64_t key, int len, int radius, int from, F &f)
+    {
+        if (radius == 0)
+        {
+            f(key);
+            return;
+        }
+
+        for (int b = from; b <= len - radius; ++b) // the flipped bits are chosen in ascending order, so every set of radius bits is visited once
+            for_each_neighbour(key ^ (std::uint64_t(1) << b), len, radius - 1, b + 1, f);
+    }
+
+    // returns the binomial coefficient n choose r as a double
+    double binomial(int n, int r)
+    {
+        double c = 1.0;
+
+        for (int i = 1; i <= r; ++i)
+            c = c * (n - r + i) / i;
+
+        return c;
+    }
+}
+
+// creates an empty index of codes of num_bits bits, num_tables > 0 enables multi-index hashing with num_tables substrings of at most 64 bits each
+HammingIndex::HammingIndex(int num_bits, int num_tables) : codes(num_bits), num_tables(num_tables)
+{
+    if (num_tables < 0 || (num_tables > 0 && (num_tables > num_bits || (num_bits + num_tables - 1) / num_tables > 64))) // the argument check
+    {
+        throw std::invalid_argument("Error: argument num_tables expects 0 or substrings of 1 to 64 bits");
+    }
+
+    this->tables.resize(num_tables);
+}
+
+// returns the first bit of the substring j
+int HammingIndex::substring_begin(int j) const
+{
+    return static_cast<int>(static_cast<long long>(j) * this->codes.bits() / this->num_tables);
+}
+
+// returns the bits of the substring j of the words
+std::uint64_t HammingIndex::substring(const unsigned long *words, int j) const
+{
+    const int begin = (*this).substring_begin(j);
+    const int end = (*this).substring_begin(j + 1);
+    std::uint64_t v = 0;
+
+    for (int part = 0; part < end - begin; part += word_bits) // one load for 64-bit cells, two for 32-bit ones
+        v |= static_cast<std::uint64_t>(bitarray_words::load(words, begin + part, end)) << part;
+
+    return v;
+}
+
+// returns the number of codes
+int HammingIndex::size() const
+{
+    return this->codes.size();
+}
+
+// returns the length of every code
+int HammingIndex::bits() const
+{
+    return this->codes.bits();
+}
+
+// returns the codes
+const BitArrayPool &HammingIndex::data() const
+{
+    return this->codes;
+}
+
+// adds the code, works only when code.size() matches the code length, returns its id
+int HammingIndex::add(const BitArrayView &code)
+{
+    int id = this->codes.push_back(code); // the sizes check is done by the pool
+    const unsigned long *words = this->codes[id].data();
+
+    for (int j = 0; j < this->num_tables; ++j)
+        this->tables[j][(*this).substring(words, j)].push_back(id);
+
+    return id;
+}
+
+// finds the k nearest codes by a scan of all codes, the results are sorted by distance and id
+std::vector<HammingMatch> HammingIndex::scan(const unsigned long *query, int k) const
+{
+    const int stride = this->codes.words_per_member();
+    TopK top(std::min(k, this->codes.size()));
+
+    switch (stride) // the common short codes get a loop of a constant number of words that the compiler unrolls
+    {
+    case 1:
+        scan_codes<1>(this->codes.data(), this->codes.size(), stride, query, top);
+        break;
+    case 2:
+        scan_codes<2>(this->codes.data(), this->codes.size(), stride, query, top);
+        break;
+    case 4:
+        scan_codes<4>(this->codes.data(), this->codes.size(), stride, query, top);
+        break;
+    case 8:
+        scan_codes<8>(this->codes.data(), this->codes.size(), stride, query, top);
+        break;
+    default:
+        scan_codes<0>(this->codes.data(), this->codes.size(), stride, query, top);
+    }
+
+    return top.sorted();
+}
+
+// finds the k nearest codes by probing the substring tables with growing radius, falls back to the scan when the probes outnumber the codes
+std::vector<HammingMatch> HammingIndex::probe(const unsigned long *query, int k) const
+{
+    const int stride = this->codes.words_per_member();
+    const int wanted = std::min(k, this->codes.size());
+    TopK top(wanted);
+    std::unordered_set<int> seen;
+    std::vector<std::uint64_t> keys(this->num_tables);
+    double probes = 0;
+    int longest = 0;
+
+    for (int j = 0; j < this->num_tables; ++j)
+    {
+        keys[j] = (*this).substring(query, j);
+        longest = std::max(longest, (*this).substring_begin(j + 1) - (*this).substring_begin(j));
+    }
+
+    for (int radius = 0; radius <= longest; ++radius)
+    {
+        for (int j = 0; j < this->num_tables; ++j)
+            probes += binomial((*this).substring_begin(j + 1) - (*this).substring_begin(j), radius);
+
+        if (probes > this->codes.size()) // the neighbours are far, probing would cost more than the scan
+            return (*this).scan(query, k);
+
+        for (int j = 0; j < this->num_tables; ++j)
+        {
+            const int len = (*this).substring_begin(j + 1) - (*this).substring_begin(j);
+
+            if (radius > len)
+                continue;
+
+            auto visit = [&](std::uint64_t key) {
+                auto bucket = this->tables[j].find(key);
+
+                if (bucket == this->tables[j].end())
+                    return;
+
+                for (int id : bucket->second)
+                {
+                    if (seen.insert(id).second)
+                        top.offer({id, distance(this->codes.data() + static_cast<std::size_t>(id) * stride, query, stride)});
+                }
+            };
+
+            for_each_neighbour(keys[j], len, radius, 0, visit);
+        }
+
+        if (static_cast<int>(seen.size()) == this->codes.size())
+            break; // every code was seen
+
+        if (top.full() && top.farthest().distance < this->num_tables * (radius + 1))
+            break; // an unseen code differs in more than radius bits of every substring, so it is at least num_tables * (radius + 1) away
+    }
+
+    return top.sorted();
+}
+
+// returns the k codes nearest to the query sorted by distance, the ties are broken by the lower id, works only when query.size() matches the code length
+std::vector<HammingMatch> HammingIndex::search(const BitArrayView &query, int k) const
+{
+    if (k < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: argument k expects value >= 0");
+    }
+
+    if (query.size() != this->codes.bits()) // the sizes check
+    {
+        throw std::runtime_error("Error: array sizes do not match");
+    }
+
+    if (k == 0 || this->codes.empty())
+        return {};
+
+    std::vector<unsigned long> words(this->codes.words_per_member(), 0UL);
+
+    if (!query.empty())
+        bitarray_words::copy(words.data(), 0, query.data(), query.bit_offset(), query.size()); // the query is aligned to the words of the codes
+
+    return this->num_tables > 0 ? (*this).probe(words.data(), k) : (*this).scan(words.data(), k);
+}
+
+// runs search for every query on num_threads threads, all hardware threads if num_threads is 0, the result k is the answer for queries[k]
+std::vector<std::vector<HammingMatch>> HammingIndex::search(const std::vector<BitArray> &queries, int k, int num_threads) const
+{
+    if (k < 0 || num_threads < 0) // the argument check
+    {
+        throw std::invalid_argument("Error: arguments k and num_threads expect values >= 0");
+    }
+
+    for (const BitArray &q : queries) // the sizes are checked before the threads start, so the threads do not throw
+    {
+        if (q.size() != this->codes.bits())
+        {
+            throw std::runtime_error("Error: array sizes do not match");
+        }
+    }
+
+    if (num_threads == 0)
+        num_threads = std::max(1U, std::thread::hardware_concurrency());
+
+    num_threads = std::max(1, std::min<int>(num_threads, static_cast<int>(queries.size())));
+
+    std::vector<std::vector<HammingMatch>> results(queries.size());
+    std::vector<std::thread> threads;
+
+    auto work = [&](int t) {
+        for (std::size_t q = t; q < queries.size(); q += num_threads) // the queries are dealt round-robin, the index is read-only and shared
+            results[q] = (*this).search(queries[q], k);
+    };
+
+    for (int t = 1; t < num_threads; ++t)
+        threads.emplace_back(work, t);
+
+    work(0);
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    return results;
+}
@@ -0,0 +1,53 @@
+#ifndef HAMMING_INDEX_HPP
+#define HAMMING_INDEX_HPP
+
+#include "bitarray_pool.hpp"
+
+#include <unordered_map>
+
+// a code found by HammingIndex::search
+struct HammingMatch
+{
+  int id{0};       // the index of the code in the order of add
+  int distance{0}; // the number of bits in which the code differs from the query
+};
+
+// k-nearest-neighbour index of equal-length binary codes by Hamming distance, the codes are kept back to back in a BitArrayPool and scanned with popcount kernels, multi-index hashing over num_tables substrings makes the search sublinear when the neighbours are close
+class HammingIndex
+{
+private:
+  BitArrayPool codes;
+  int num_tables{0};
+  std::vector<std::unordered_map<std::uint64_t, std::vector<int>>> tables; // the table j maps the bits of the substring j of a code to the ids of the codes with these bits
+
+  // returns the first bit of the substring j
+  int substring_begin(int j) const;
+  // returns the bits of the substring j of the words
+  std::uint64_t substring(const unsigned long *words, int j) const;
+
+  // finds the k nearest codes by a scan of all codes, the results are sorted by distance and id
+  std::vector<HammingMatch> scan(const unsigned long *query, int k) const;
+  // finds the k nearest codes by probing the substring tables with growing radius, falls back to the scan when the probes outnumber the codes
+  std::vector<HammingMatch> probe(const unsigned long *query, int k) const;
+
+public:
+  // creates an empty index of codes of num_bits bits, num_tables > 0 enables multi-index hashing with num_tables substrings of at most 64 bits each
+  explicit HammingIndex(int num_bits, int num_tables = 0);
+
+  // returns the number of codes
+  int size() const;
+  // returns the length of every code
+  int bits() const;
+  // returns the codes
+  const BitArrayPool &data() const;
+
+  // adds the code, works only when code.size() matches the code length, returns its id
+  int add(const BitArrayView &code);
+
+  // returns the k codes nearest to the query sorted by distance, the ties are broken by the lower id, works only when query.size() matches the code length
+  std::vector<HammingMatch> search(const BitArrayView &query, int k) const;
+  // runs search for every query on num_threads threads, all hardware threads if num_threads is 0, the result k is the answer for queries[k]
+  std::vector<std::vector<HammingMatch>> search(const std::vector<BitArray> &queries, int k, int num_threads = 0) const;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "../lib/bitap.hpp"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+namespace
+{
+    std::string random_text(int n, int alphabet, unsigned long seed)
+    {
+        std::string text(n, 'a');
+        for (int i = 0; i < n; ++i)
+        {
+            seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+            text[i] = static_cast<char>('a' + (seed >> 33) % alphabet);
+        }
+        return text;
+    }
+
+    // the ends of the matches of the pattern with at most k errors found by dynamic programming
+    std::set<std::pair<int, long long>> reference(const std::vector<std::string> &patterns, const std::string &text, int k, BitapMode mode)
+    {
+        std::set<std::pair<int, long long>> ends;
+        for (int p = 0; p < static_cast<int>(patterns.size()); ++p)
+        {
+            const std::string &pat = patterns[p];
+            const int m = static_cast<int>(pat.size());
+            if (mode != BitapMode::edit)
+            {
+                for (int e = m; e <= static_cast<int>(text.size()); ++e)
+                {
+                    int errors = 0;
+                    for (int i = 0; i < m; ++i)
+                        errors += pat[i] != text[e - m + i];
+                    if (errors <= k)
+                        ends.insert({p, e});
+                }
+                continue;
+            }
+            std::vector<int> column(m + 1);
+            for (int i = 0; i <= m; ++i)
+                column[i] = i;
+            for (int e = 1; e <= static_cast<int>(text.size()); ++e)
+            {
+                std::vector<int> next(m + 1, 0);
+                for (int i = 1; i <= m; ++i)
+                    next[i] = std::min({column[i] + 1, next[i - 1] + 1, column[i - 1] + (pat[i - 1] != text[e - 1])});
+                column = next;
+                if (column[m] <= k)
+                    ends.insert({p, e});
+            }
+        }
+        return ends;
+    }
+
+    std::set<std::pair<int, long long>> as_set(const std::vector<BitapMatch> &matches)
+    {
+        std::set<std::pair<int, long long>> ends;
+        for (const BitapMatch &m : matches)
+            ends.insert({m.pattern, m.end});
+        EXPECT_EQ(ends.size(), matches.size());
+        return ends;
+    }
+}
+
+TEST(Bitap_test, arguments)
+{
+    EXPECT_THROW(BitapMatcher({}), std::invalid_argument);
+    EXPECT_THROW(BitapMatcher({""}), std::invalid_argument);
+    EXPECT_THROW(BitapMatcher({"abc"}, 1), std::invalid_argument);
+    EXPECT_THROW(BitapMatcher({"ab", "abc"}, 2, BitapMode::edit), std::invalid_argument);
+    EXPECT_THROW(BitapMatcher({"abc"}, -1, BitapMode::mismatch), std::invalid_argument);
+    EXPECT_THROW(BitapMatcher({std::string(100, 'a')}, 64, BitapMode::mismatch), std::invalid_argument);
+}
+
+TEST(Bitap_test, exact)
+{
+    BitapMatcher matcher({"abra", "cad", "a"});
+    EXPECT_EQ(matcher.num_patterns(), 3);
+    std::set<std::pair<int, long long>> expected = {{0, 4}, {0, 11}, {1, 7}, {2, 1}, {2, 4}, {2, 6}, {2, 8}, {2, 11}};
+    EXPECT_EQ(as_set(matcher.find_all("abracadabra")), expected);
+    EXPECT_EQ(matcher.position(), 11);
+
+    std::string text = random_text(5000, 3, 1);
+    std::vector<std::string> patterns = {text.substr(100, 150), text.substr(4000, 70), "abcab", text.substr(2000, 64)};
+    BitapMatcher multi(patterns);
+    EXPECT_EQ(as_set(multi.find_all(text)), reference(patterns, text, 0, BitapMode::exact));
+}
+
+TEST(Bitap_test, errors)
+{
+    std::string text = random_text(3000, 4, 2);
+    std::vector<std::string> patterns = {text.substr(10, 20), text.substr(500, 90), "abcdabcd"};
+    patterns[1][30] = 'z';
+    patterns[1][60] = 'z';
+    patterns[1].erase(45, 1);
+
+    for (int k = 0; k <= 3; ++k)
+    {
+        BitapMatcher hamming(patterns, k, BitapMode::mismatch);
+        EXPECT_EQ(as_set(hamming.find_all(text)), reference(patterns, text, k, BitapMode::mismatch)) << k;
+
+        BitapMatcher edit(patterns, k, BitapMode::edit);
+        std::set<std::pair<int, long long>> found = as_set(edit.find_all(text));
+        EXPECT_EQ(found, reference(patterns, text, k, BitapMode::edit)) << k;
+        EXPECT_EQ(found.count({1, 590}) == 1, k >= 3) << k;
+    }
+}
+
+TEST(Bitap_test, streaming)
+{
+    std::string text = random_text(10000, 2, 3);
+    std::vector<std::string> patterns = {text.substr(1234, 100), text.substr(20, 7)};
+    BitapMatcher matcher(patterns, 2, BitapMode::edit);
+    std::vector<BitapMatch> whole = matcher.find_all(text);
+
+    matcher.reset();
+    std::vector<BitapMatch> pieces;
+    for (std::size_t pos = 0; pos < text.size(); pos += 333)
+        matcher.feed(text.data() + pos, std::min<std::size_t>(333, text.size() - pos), pieces);
+
+    EXPECT_EQ(as_set(pieces), as_set(whole));
+    EXPECT_EQ(matcher.position(), 10000);
+}
@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include "../lib/bitarray.hpp"
+#include "../lib/bitarray_random.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// std::uint64_t is BitArray itself where unsigned long is 64-bit, unsigned long long is a separate instantiation there
+template <typename Word>
+class BasicBitArray_test : public ::testing::Test
+{
+};
+
+#if defined(__SIZEOF_INT128__)
+using BasicBitArray_words = ::testing::Types<std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, unsigned long long, unsigned __int128>;
+#else
+using BasicBitArray_words = ::testing::Types<std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, unsigned long long>;
+#endif
+TYPED_TEST_SUITE(BasicBitArray_test, BasicBitArray_words);
+
+namespace
+{
+    // copies the bits of arr to a BasicBitArray of the word type
+    template <typename Word>
+    BasicBitArray<Word> convert(const BitArray &arr)
+    {
+        BasicBitArray<Word> b(arr.size());
+
+        for (int i = 0; i < arr.size(); ++i)
+            b.set(i, arr[i]);
+
+        return b;
+    }
+}
+
+TEST(BasicBitArray_test, alias)
+{
+    EXPECT_TRUE((std::is_same<BitArray, BasicBitArray<unsigned long>>::value));
+    EXPECT_TRUE((std::is_nothrow_move_constructible<BasicBitArray<std::uint8_t>>::value));
+    EXPECT_EQ(BasicBitArray<std::uint8_t>::dim, 8);
+    EXPECT_EQ(BasicBitArray<std::uint16_t>::dim, 16);
+    EXPECT_EQ(BitArray::dim, static_cast<int>(sizeof(unsigned long) * 8));
+}
+
+TYPED_TEST(BasicBitArray_test, matches_bitarray)
+{
+    using Array = BasicBitArray<TypeParam>;
+    Xoshiro256 rng(17);
+    const int sizes[] = {1, 7, 8, 9, 63, 64, 65, 127, 128, 129, 300};
+
+    Array empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_THROW(empty[0], std::invalid_argument);
+    EXPECT_THROW(empty.count(), std::invalid_argument);
+    EXPECT_THROW(Array(-1), std::invalid_argument);
+
+    for (int num_bits : sizes)
+    {
+        BitArray a(num_bits);
+        BitArray b(num_bits);
+        a.fill_random(rng);
+        b.fill_random(rng);
+        Array x = convert<TypeParam>(a);
+        Array y = convert<TypeParam>(b);
+
+        EXPECT_EQ(x.size(), num_bits);
+        EXPECT_EQ(x.to_string(), a.to_string());
+        EXPECT_EQ(x.count(), a.count());
+        EXPECT_EQ(x.any(), a.any());
+        EXPECT_EQ(x.all(), a.all());
+        EXPECT_EQ(x.hash(), a.hash()) << "the hash mixes 64-bit words whatever the word type";
+        EXPECT_EQ((~x).to_string(), (~a).to_string());
+        EXPECT_EQ((x & y).to_string(), (a & b).to_string());
+        EXPECT_EQ((x | y).to_string(), (a | b).to_string());
+        EXPECT_EQ((x ^ y).to_string(), (a ^ b).to_string());
+        EXPECT_EQ(x < y, a < b);
+        EXPECT_EQ(x.compare(y), a.compare(b));
+        EXPECT_THROW(x[num_bits], std::out_of_range);
+        EXPECT_THROW(x &= Array(num_bits + 1), std::runtime_error);
+
+        for (int n : {0, 1, 5, 8, 31, 64, 65, 200, 400})
+        {
+            EXPECT_EQ((x << n).to_string(), (a << n).to_string()) << n;
+            EXPECT_EQ((x >> n).to_string(), (a >> n).to_string()) << n;
+            EXPECT_EQ(x.rotl(n).to_string(), a.rotl(n).to_string()) << n;
+            EXPECT_EQ(Array(x).or_shifted(y, n).to_string(), BitArray(a).or_shifted(b, n).to_string()) << n;
+            EXPECT_EQ(Array(x).andnot_shifted(y, n).to_string(), BitArray(a).andnot_shifted(b, n).to_string()) << n;
+        }
+
+        EXPECT_TRUE(x == convert<TypeParam>(a));
+        EXPECT_EQ(x != y, a != b);
+
+        std::vector<std::uint32_t> xi;
+        std::vector<std::uint32_t> ai;
+        x.append_indices(xi);
+        a.append_indices(ai);
+        EXPECT_EQ(xi, ai);
+
+        if (a.any())
+        {
+            EXPECT_EQ(x.select(a.count() - 1), a.select(a.count() - 1));
+        }
+
+        Array sum(x);
+        BitArray sum_a(a);
+        EXPECT_EQ(sum.add(y), sum_a.add(b));
+        EXPECT_EQ(sum.to_string(), sum_a.to_string());
+        EXPECT_EQ(sum.sub(y), sum_a.sub(b));
+        EXPECT_EQ(sum.to_string(), a.to_string());
+        EXPECT_EQ(sum.increment(), sum_a.increment());
+        EXPECT_EQ(sum.negate().to_string(), sum_a.negate().to_string());
+
+        Array product(x);
+        BitArray product_a(a);
+        EXPECT_EQ(static_cast<unsigned long>(product.multiply(0xB5)), product_a.multiply(0xB5));
+        EXPECT_EQ(product.to_string(), product_a.to_string());
+
+        std::vector<std::uint64_t> words((num_bits + 63) / 64);
+        x.to_words(words.data());
+        std::vector<std::uint64_t> words_a(words.size());
+        a.to_words(words_a.data());
+        EXPECT_EQ(words, words_a);
+        EXPECT_TRUE(Array::from_words(words.data(), num_bits) == x);
+
+        std::vector<unsigned char> bytes((num_bits + 63) / 64 * 8);
+        x.to_bytes(bytes.data(), ByteOrder::big, BitOrder::msb_first);
+        EXPECT_TRUE(Array::from_bytes(bytes.data(), num_bits, ByteOrder::big, BitOrder::msb_first) == x);
+
+        std::vector<TypeParam> legacy((num_bits + Array::dim - 1) / Array::dim);
+        x.to_legacy(legacy.data());
+        EXPECT_TRUE(Array::from_legacy(legacy.data(), num_bits) == x);
+
+        std::unique_ptr<std::uint64_t[]> buffer(new std::uint64_t[words.size()]);
+        std::copy(words.begin(), words.end(), buffer.get());
+        Array adopted;
+        adopted.adopt(std::move(buffer), num_bits);
+        EXPECT_TRUE(adopted == x);
+
+        EXPECT_EQ(x.to_vector(), a.to_vector());
+        EXPECT_EQ(x.extract(num_bits / 3, (num_bits + 1) / 2).to_string(), a.extract(num_bits / 3, (num_bits + 1) / 2).to_string());
+
+        x.set();
+        EXPECT_EQ(x.count(), num_bits);
+        EXPECT_TRUE((~x).none());
+        x.reset();
+        EXPECT_TRUE(x.none());
+    }
+
+    std::bitset<130> bits;
+    bits.set(0).set(70).set(129);
+    Array from_bits = Array::from_bitset(bits);
+    EXPECT_EQ(from_bits.count(), 3);
+    EXPECT_TRUE(from_bits[70]);
+    EXPECT_EQ(from_bits.template to_bitset<130>(), bits);
+
+    Array grow(3, 5);
+    EXPECT_EQ(grow.to_string(), "101");
+    for (int i = 0; i < 140; ++i)
+        grow.push_back(i % 3 == 0);
+    EXPECT_EQ(grow.size(), 143);
+    EXPECT_EQ(grow.count(), 2 + 47);
+    grow.resize(10);
+    EXPECT_EQ(grow.to_string(), "1011001001");
+    grow.resize(20, true);
+    EXPECT_EQ(grow.to_string(), "10110010011111111111");
+    BitArray grow_a = BitArray::from_words(std::vector<std::uint64_t>{0xFFE4DULL}.data(), 20);
+    EXPECT_EQ(grow_a.to_string(), grow.to_string());
+    grow.insert(2, Array(3, 7)).erase(0, 2);
+    grow_a.insert(2, BitArray(3, 7)).erase(0, 2);
+    EXPECT_EQ(grow.to_string(), grow_a.to_string());
+    grow.resize(0);
+    EXPECT_TRUE(grow.empty());
+
+    Array copy(Array(9, 1));
+    Array moved(std::move(copy));
+    EXPECT_EQ(moved.to_string(), "100000000");
+    copy = moved;
+    copy.reset(0).set(8);
+    EXPECT_EQ(copy.to_string(), "000000001");
+    EXPECT_EQ(moved.to_string(), "100000000");
+}
+
+TYPED_TEST(BasicBitArray_test, batches_and_tracking)
+{
+    using Array = BasicBitArray<TypeParam>;
+    Xoshiro256 rng(5);
+
+    Array x(1000);
+    const int indices[] = {999, 3, 64, 65, 128, 500, 3};
+    x.set_many(indices, 7);
+    EXPECT_EQ(x.count(), 6);
+    x.flip_many(indices, 2);
+    EXPECT_FALSE(x[999]);
+    EXPECT_FALSE(x[3]);
+
+    bool out[7];
+    x.test_many(indices, 7, out);
+    EXPECT_TRUE(out[2] && out[3] && out[4] && out[5]);
+    x.reset_many(indices + 2, 4);
+    EXPECT_TRUE(x.none());
+
+    x.fill_bernoulli(0.25, rng);
+    EXPECT_GT(x.count(), 150);
+    EXPECT_LT(x.count(), 350);
+    EXPECT_TRUE(x[x.random_set_bit(rng)]);
+
+    x.fill_random(rng);
+    x.cache_count();
+    EXPECT_EQ(x.count(), x.count());
+    x.set(0, !x[0]);
+    int expected = 0;
+    for (int i = 0; i < x.size(); ++i)
+        expected += x[i];
+    EXPECT_EQ(x.count(), expected);
+
+    Array copy(x);
+    x.track_changes();
+    x.set(700).reset(5).rotate_left(0);
+    x.or_shifted(Array(1000, 1), 300);
+    Array applied(copy);
+    applied.apply_delta(x.delta());
+    EXPECT_TRUE(applied == x);
+    x.clear_changes();
+    EXPECT_TRUE(x.delta().ranges.empty());
+}
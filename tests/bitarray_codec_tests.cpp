@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "../lib/bitarray_codec.hpp"
+
+namespace
+{
+    BitArray sparse(int num_bits, int every, unsigned long seed)
+    {
+        BitArray arr(num_bits);
+        for (int i = 0; i < num_bits; ++i)
+        {
+            seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+            if ((seed >> 33) % every == 0)
+                arr.set(i);
+        }
+        return arr;
+    }
+}
+
+TEST(BitArrayCodec_test, elias_fano)
+{
+    const int densities[] = {1, 2, 7, 100, 5000};
+    for (int every : densities)
+    {
+        BitArray arr = sparse(100000, every, every);
+        EliasFano e = elias_fano_encode(arr);
+        EXPECT_EQ(e.num_bits, 100000);
+        EXPECT_EQ(e.num_ones, arr.count());
+        EXPECT_LE(e.low.size() + e.high.size(), e.num_ones * (e.low_bits + 3) + 1);
+        EXPECT_EQ(elias_fano_decode(e), arr);
+
+        BitArray out(100000);
+        out.set();
+        elias_fano_decode(e, out);
+        EXPECT_EQ(out, arr);
+    }
+
+    BitArray arr(300);
+    arr.set(0).set(299);
+    EliasFano e = elias_fano_encode(arr);
+    EXPECT_EQ(e.low_bits, 7);
+    EXPECT_EQ(elias_fano_decode(e), arr);
+    EXPECT_TRUE(elias_fano_decode(elias_fano_encode(BitArray(70))).none());
+    EXPECT_TRUE(elias_fano_decode(elias_fano_encode(BitArray())).empty());
+
+    BitArray wrong(299);
+    EXPECT_THROW(elias_fano_decode(e, wrong), std::runtime_error);
+    e.high.set(e.high.size() - 1);
+    EXPECT_THROW(elias_fano_decode(e), std::invalid_argument);
+    e.low_bits = 3;
+    EXPECT_THROW(elias_fano_decode(e), std::invalid_argument);
+}
+
+TEST(BitArrayCodec_test, vbyte)
+{
+    const int densities[] = {1, 2, 7, 100, 300, 70000};
+    for (int every : densities)
+    {
+        BitArray arr = sparse(1000000, every, every);
+        VByteList list = vbyte_encode(arr);
+        EXPECT_EQ(list.num_bits, 1000000);
+        EXPECT_EQ(list.num_ones, arr.count());
+        EXPECT_EQ(list.control.size(), static_cast<std::size_t>(list.num_ones + 3) / 4);
+        EXPECT_EQ(vbyte_decode(list), arr);
+
+        BitArray out(1000000);
+        out.set(5);
+        vbyte_decode(list, out);
+        EXPECT_EQ(out, arr);
+    }
+
+    BitArray dense(100);
+    dense.set();
+    EXPECT_EQ(vbyte_encode(dense).data, std::vector<unsigned char>(100, 0));
+
+    BitArray arr(1 << 29);
+    arr.set(0).set(3).set(300).set(70000).set(1 << 26).set((1 << 29) - 1);
+    VByteList list = vbyte_encode(arr);
+    EXPECT_EQ(list.data.size(), 1 + 1 + 2 + 3 + 4 + 4);
+    EXPECT_EQ(vbyte_decode(list), arr);
+    EXPECT_TRUE(vbyte_decode(vbyte_encode(BitArray())).empty());
+
+    list.data.push_back(0);
+    EXPECT_THROW(vbyte_decode(list), std::invalid_argument);
+    list.data.pop_back();
+    list.data.back() = 0xFF;
+    EXPECT_THROW(vbyte_decode(list), std::invalid_argument);
+    list.control.pop_back();
+    EXPECT_THROW(vbyte_decode(list), std::invalid_argument);
+}
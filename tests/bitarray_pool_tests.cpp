@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "../lib/bitarray_pool.hpp"
+#include "../lib/bitarray_random.hpp"
+
+#include <climits>
+
+TEST(BitArrayPool_test, members)
+{
+    BitArrayPool empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_THROW(BitArrayPool(-1), std::invalid_argument);
+    BitArrayPool wide(INT_MAX); // the member length is rounded up to whole words without overflow
+    EXPECT_EQ(wide.bits(), INT_MAX);
+    EXPECT_TRUE(wide.empty());
+
+    BitArrayPool pool(300, 3);
+    EXPECT_EQ(pool.size(), 3);
+    EXPECT_EQ(pool.bits(), 300);
+    EXPECT_EQ(pool.words_per_member(), (300 + BitArrayPool::dim - 1) / BitArrayPool::dim);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(pool.data()) % BitArray::alignment, 0);
+    EXPECT_THROW(pool[3], std::out_of_range);
+
+    pool[1].set(5).set(299);
+    EXPECT_EQ(pool[1].count(), 2);
+    EXPECT_EQ(pool[0].count(), 0);
+
+    BitArray arr(300);
+    arr.set(7);
+    EXPECT_EQ(pool.push_back(arr), 3);
+    EXPECT_THROW(pool.push_back(BitArray(10)), std::runtime_error);
+
+    for (int k = 0; k < 100; ++k)
+        pool.push_back(pool[1]); // the view of a member is read before the slab grows
+    EXPECT_EQ(pool.size(), 104);
+    EXPECT_EQ(pool[103].view().to_bitarray(), pool[1].view().to_bitarray());
+    EXPECT_TRUE(pool[3][7]);
+
+    BitArrayPool copy(pool);
+    pool.clear();
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.push_back(), 0);
+    EXPECT_EQ(pool[0].count(), 0);
+    EXPECT_EQ(copy.size(), 104);
+    EXPECT_EQ(copy[50].count(), 2);
+
+    pool = copy;
+    EXPECT_EQ(pool.size(), 104);
+    EXPECT_EQ(pool[3].view().to_bitarray(), arr);
+}
+
+TEST(BitArrayPool_test, move)
+{
+    BitArrayPool pool(130, 4);
+    pool[2].set(129);
+    const unsigned long *slab = pool.data();
+
+    BitArrayPool moved(std::move(pool));
+    EXPECT_EQ(moved.data(), slab); // the slab is taken, not copied
+    EXPECT_EQ(moved.size(), 4);
+    EXPECT_TRUE(moved[2][129]);
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.bits(), 130);
+    EXPECT_EQ(pool.push_back(), 0); // a moved-from pool is usable
+    EXPECT_EQ(pool[0].count(), 0);
+
+    BitArrayPool other(10, 1);
+    other = std::move(moved);
+    EXPECT_EQ(other.data(), slab);
+    EXPECT_EQ(other.bits(), 130);
+    EXPECT_EQ(other[2].count(), 1);
+    EXPECT_TRUE(moved.empty());
+
+    std::vector<BitArrayPool> pools;
+    for (int k = 0; k < 20; ++k)
+        pools.push_back(BitArrayPool(64, k)); // the vector moves the pools when it grows
+    EXPECT_EQ(pools[19].size(), 19);
+}
+
+TEST(BitArrayPool_test, batch_operations)
+{
+    Xoshiro256 rng(4);
+    const int num_bits = 1000;
+    BitArrayPool pool(num_bits);
+    std::vector<BitArray> reference;
+
+    for (int k = 0; k < 500; ++k)
+    {
+        BitArray arr(num_bits);
+        arr.fill_bernoulli(k / 500.0, rng);
+        reference.push_back(arr);
+        pool.push_back(arr);
+    }
+
+    std::vector<int> counts = pool.count_all();
+    for (int k = 0; k < 500; ++k)
+        EXPECT_EQ(counts[k], reference[k].count());
+
+    BitArray big(num_bits + 70);
+    big.fill_random(rng);
+    BitArrayView mask(big, 35, num_bits);
+    BitArray m = mask.to_bitarray();
+
+    counts = pool.count_and(mask);
+    for (int k = 0; k < 500; ++k)
+        EXPECT_EQ(counts[k], (reference[k] & m).count());
+
+    pool.and_all(mask);
+    for (int k = 0; k < 500; ++k)
+        EXPECT_EQ(pool[k].view().to_bitarray(), reference[k] & m);
+
+    pool.or_all(pool[499]);
+    for (int k = 0; k < 500; ++k)
+        EXPECT_EQ(pool[k].view().to_bitarray(), (reference[k] & m) | (reference[499] & m));
+
+    EXPECT_THROW(pool.and_all(BitArray(5)), std::runtime_error);
+    EXPECT_THROW(pool.count_and(BitArray(5)), std::runtime_error);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../lib/bitarray_snapshot.hpp"
+#include "../lib/bitarray_random.hpp"
+
+#include <atomic>
+#include <thread>
+
+TEST(SharedBitArray_test, copy_on_write)
+{
+    EXPECT_THROW(SharedBitArray(-1), std::invalid_argument);
+    EXPECT_THROW(SharedBitArray(100, 0), std::invalid_argument);
+    EXPECT_THROW(SharedBitArray(100, SharedBitArray::dim + 1), std::invalid_argument);
+    EXPECT_THROW(SharedBitArray(100, 3 * SharedBitArray::dim), std::invalid_argument);
+    EXPECT_TRUE(SharedBitArray(0).snapshot().empty());
+    EXPECT_THROW(BitArraySnapshot()[0], std::invalid_argument);
+
+    const int block_bits = 4 * SharedBitArray::dim;
+    SharedBitArray shared(10 * block_bits + 5, block_bits);
+    BitArraySnapshot first = shared.snapshot();
+    EXPECT_EQ(first.size(), 10 * block_bits + 5);
+    EXPECT_EQ(first.num_blocks(), 11);
+    EXPECT_EQ(first.block(10).size(), 5);
+    EXPECT_EQ(first.version_number(), 0U);
+    EXPECT_FALSE(first.any());
+
+    shared.set(3).set(block_bits + 1).set(10 * block_bits + 4);
+    EXPECT_TRUE(shared.test(3));
+    EXPECT_EQ(shared.pending_blocks(), 3);
+    EXPECT_FALSE(shared.snapshot()[3]); // the draft is not seen before publish
+    EXPECT_THROW(shared.set(10 * block_bits + 5), std::out_of_range);
+
+    EXPECT_EQ(shared.publish(), 1U);
+    EXPECT_EQ(shared.pending_blocks(), 0);
+    EXPECT_EQ(shared.publish(), 1U); // nothing changed
+
+    BitArraySnapshot second = shared.snapshot();
+    EXPECT_EQ(second.version_number(), 1U);
+    EXPECT_EQ(second.count(), 3);
+    EXPECT_TRUE(second[10 * block_bits + 4]);
+    EXPECT_EQ(first.count(), 0); // the old snapshot keeps its bits
+    EXPECT_NE(second.block(0).data(), first.block(0).data());
+    EXPECT_EQ(second.block(2).data(), first.block(2).data()); // the unchanged blocks are shared
+
+    shared.set(3); // an unchanged bit copies nothing
+    EXPECT_EQ(shared.pending_blocks(), 0);
+    shared.reset(3).set(4);
+    EXPECT_EQ(shared.pending_blocks(), 1);
+    shared.discard();
+    EXPECT_TRUE(shared.test(3));
+    EXPECT_FALSE(shared.test(4));
+    EXPECT_EQ(shared.publish(), 1U);
+}
+
+TEST(SharedBitArray_test, assign_and_delta)
+{
+    Xoshiro256 rng(21);
+    const int num_bits = 5000;
+    BitArray arr(num_bits);
+    arr.fill_random(rng);
+
+    SharedBitArray shared(arr, 1024);
+    BitArraySnapshot before = shared.snapshot();
+    EXPECT_EQ(before.to_bitarray(), arr);
+    EXPECT_EQ(before.version_number(), 1U);
+
+    arr.set(2100, !arr[2100]);
+    shared.assign(arr);
+    EXPECT_EQ(shared.pending_blocks(), 1); // only the block of the changed bit is copied
+    shared.publish();
+    EXPECT_EQ(shared.snapshot().to_bitarray(), arr);
+    EXPECT_THROW(shared.assign(BitArray(10)), std::runtime_error);
+
+    BitArray replica(arr);
+    replica.track_changes();
+    replica.set(10).reset(4999).set(3000, !replica[3000]);
+    shared.apply_delta(replica.delta());
+    EXPECT_LE(shared.pending_blocks(), 3);
+    shared.publish();
+    EXPECT_EQ(shared.snapshot().to_bitarray(), replica);
+    EXPECT_EQ(before.to_bitarray().count(), before.count());
+
+    BitArrayDelta other;
+    other.num_bits = 10;
+    EXPECT_THROW(shared.apply_delta(other), std::runtime_error);
+    other.ranges = {0};
+    EXPECT_THROW(shared.apply_delta(other), std::invalid_argument);
+}
+
+TEST(SharedBitArray_test, concurrent_readers)
+{
+    const int num_bits = 1 << 16;
+    const int num_true = 100;
+    SharedBitArray shared(num_bits, 512);
+    std::atomic<bool> done(false);
+    std::atomic<int> failures(0);
+
+    for (int i = 0; i < num_true; ++i)
+        shared.set(i * 7);
+    shared.publish();
+
+    auto reader = [&] {
+        std::uint64_t last = 0;
+        while (!done.load())
+        {
+            BitArraySnapshot s = shared.snapshot();
+            if (s.count() != num_true || s.version_number() < last) // every version moves one true bit, so the count never changes
+                failures++;
+            last = s.version_number();
+        }
+    };
+
+    std::thread r1(reader);
+    std::thread r2(reader);
+    Xoshiro256 rng(22);
+
+    for (int round = 0; round < 2000; ++round)
+    {
+        int from = static_cast<int>(rng() % num_bits);
+        while (!shared.test(from))
+            from = (from + 1) % num_bits;
+        int to = static_cast<int>(rng() % num_bits);
+        while (shared.test(to))
+            to = (to + 1) % num_bits;
+        shared.reset(from).set(to);
+        shared.publish();
+    }
+
+    done = true;
+    r1.join();
+    r2.join();
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(shared.snapshot().version_number(), 2001U);
+    EXPECT_EQ(shared.snapshot().count(), num_true);
+}
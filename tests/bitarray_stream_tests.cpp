@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "../lib/bitarray_stream.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    BitArray pattern(int num_bits, unsigned long seed)
+    {
+        BitArray arr(num_bits);
+        for (int i = 0; i < num_bits; ++i)
+        {
+            seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+            arr.set(i, (seed >> 40) % 3 == 0);
+        }
+        return arr;
+    }
+
+    void write_file(const std::string &path, const BitArray &arr)
+    {
+        std::vector<unsigned char> bytes((arr.size() + 63) / 64 * 8, 0);
+        arr.to_bytes(bytes.data()); // the file holds little-endian 64-bit words on every host
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    }
+
+    BitArray read_file(const std::string &path, int num_bits)
+    {
+        std::vector<unsigned char> bytes((num_bits + 63) / 64 * 8);
+        std::ifstream file(path, std::ios::binary);
+        file.read(reinterpret_cast<char *>(bytes.data()), bytes.size());
+        EXPECT_EQ(file.gcount(), static_cast<std::streamsize>(bytes.size()));
+        return BitArray::from_bytes(bytes.data(), num_bits);
+    }
+}
+
+TEST(BitArrayStream_test, count)
+{
+    const std::string path = ::testing::TempDir() + "bitarray_stream_count.bin";
+    BitArray arr = pattern(100000, 1);
+    write_file(path, arr);
+
+    EXPECT_EQ(stream_count(path), arr.count());
+    EXPECT_EQ(stream_count(path, 64), arr.count());
+    EXPECT_EQ(stream_count(path, 8), arr.count());
+    EXPECT_THROW(stream_count(path, 12), std::invalid_argument);
+    EXPECT_THROW(stream_count(path, 0), std::invalid_argument);
+    EXPECT_THROW(stream_count(::testing::TempDir() + "bitarray_stream_missing.bin"), std::runtime_error);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc).close();
+    EXPECT_EQ(stream_count(path), 0);
+    std::remove(path.c_str());
+}
+
+TEST(BitArrayStream_test, combine)
+{
+    const std::string a = ::testing::TempDir() + "bitarray_stream_a.bin";
+    const std::string b = ::testing::TempDir() + "bitarray_stream_b.bin";
+    const std::string out = ::testing::TempDir() + "bitarray_stream_out.bin";
+    BitArray arr1 = pattern(100000, 2);
+    BitArray arr2 = pattern(100000, 3);
+    write_file(a, arr1);
+    write_file(b, arr2);
+
+    stream_and(a, b, out, 64);
+    EXPECT_EQ(read_file(out, 100000), arr1 & arr2);
+    stream_or(a, b, out, 1024);
+    EXPECT_EQ(read_file(out, 100000), arr1 | arr2);
+    stream_xor(a, b, out);
+    EXPECT_EQ(read_file(out, 100000), arr1 ^ arr2);
+    EXPECT_EQ(stream_count(out, 256), (arr1 ^ arr2).count());
+
+    write_file(b, pattern(1000, 3));
+    EXPECT_THROW(stream_and(a, b, out), std::runtime_error);
+    EXPECT_THROW(stream_combine(a, ::testing::TempDir() + "bitarray_stream_missing.bin", out, StreamOp::bit_or), std::runtime_error);
+
+    std::remove(a.c_str());
+    std::remove(b.c_str());
+    std::remove(out.c_str());
+}
+
+TEST(BitArrayStream_test, combine_into_input)
+{
+    const std::string a = ::testing::TempDir() + "bitarray_stream_alias_a.bin";
+    const std::string b = ::testing::TempDir() + "bitarray_stream_alias_b.bin";
+    BitArray arr1 = pattern(10000, 4);
+    BitArray arr2 = pattern(10000, 5);
+    write_file(a, arr1);
+    write_file(b, arr2);
+
+    EXPECT_THROW(stream_and(a, b, a), std::invalid_argument);
+    EXPECT_THROW(stream_or(a, b, b), std::invalid_argument);
+    EXPECT_THROW(stream_xor(a, b, ::testing::TempDir() + "./bitarray_stream_alias_a.bin"), std::invalid_argument); // another path to the same file
+    EXPECT_EQ(read_file(a, 10000), arr1); // the inputs are left untouched
+    EXPECT_EQ(read_file(b, 10000), arr2);
+
+    std::remove(a.c_str());
+    std::remove(b.c_str());
+}
@@ -1,5 +1,13 @@
 #include <gtest/gtest.h>
 #include "../lib/bitarray.hpp"
+#include "../lib/bitarray_random.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <set>
+#include <thread>
+#include <unordered_set>
 
 TEST(BitArray_test, default_constructor)
 {
@@ -25,7 +33,7 @@ TEST(BitArray_test, destructor)
 
 TEST(BitArray_test, parameterized_constructor)
 {
-    BitArray arr(64, ~0UL);
+    BitArray arr(64, 0xFFFFFFFFUL);
     EXPECT_EQ(arr.size(), 64);
     EXPECT_TRUE(arr[0]);
     EXPECT_FALSE(arr[32]);
@@ -88,7 +96,7 @@ TEST(BitArray_test, assignment_operator)
 
 TEST(BitArray_test, resize)
 {
-    BitArray arr(32, 0b1111);
+    BitArray arr(32, 0b1111UL << 20);
     EXPECT_THROW(arr.resize(-1), std::invalid_argument);
     EXPECT_THROW(arr[40], std::out_of_range);
     arr.resize(64, true);
@@ -181,7 +189,7 @@ TEST(BitArray_test, left_shift)
 {
     BitArray arr(32, 0b101010);
     arr <<= 2;
-    EXPECT_EQ(arr.to_string(), BitArray(32, 0b10101000).to_string());
+    EXPECT_EQ(arr.to_string(), BitArray(32, 0b1010).to_string());
     arr <<= 32;
     EXPECT_TRUE(arr.none());
     EXPECT_THROW(arr <<= -1, std::invalid_argument);
@@ -199,7 +207,7 @@ TEST(BitArray_test, right_shift)
 {
     BitArray arr(32, 0b101010);
     arr >>= 2;
-    EXPECT_EQ(arr.to_string(), BitArray(32, 0b001010).to_string());
+    EXPECT_EQ(arr.to_string(), BitArray(32, 0b10101000).to_string());
     arr >>= 32;
     EXPECT_TRUE(arr.none());
     EXPECT_THROW(arr >>= -1, std::invalid_argument);
@@ -217,7 +225,7 @@ TEST(BitArray_test, left_shift_2)
 {
     BitArray arr1(32, 0b101010);
     BitArray arr2 = arr1 << 2;
-    EXPECT_EQ(arr2.to_string(), BitArray(32, 0b10101000).to_string());
+    EXPECT_EQ(arr2.to_string(), BitArray(32, 0b1010).to_string());
     arr1 = arr2 << 32;
     EXPECT_TRUE(arr1.none());
     EXPECT_THROW(arr1 << -1, std::invalid_argument);
@@ -236,7 +244,7 @@ TEST(BitArray_test, right_shift_2)
 {
     BitArray arr1(32, 0b101010);
     BitArray arr2 = arr1 >> 2;
-    EXPECT_EQ(arr2.to_string(), BitArray(32, 0b001010).to_string());
+    EXPECT_EQ(arr2.to_string(), BitArray(32, 0b10101000).to_string());
     arr1 = arr2 >> 32;
     EXPECT_TRUE(arr1.none());
     EXPECT_THROW(arr1 >> -1, std::invalid_argument);
@@ -367,8 +375,8 @@ TEST(BitArray_test, count)
 TEST(BitArray_test, access_operator)
 {
     BitArray arr(32, 0b1010);
-    EXPECT_TRUE(arr[28]);
-    EXPECT_FALSE(arr[29]);
+    EXPECT_TRUE(arr[3]);
+    EXPECT_FALSE(arr[2]);
     arr.clear();
     arr.push_back(true);
     EXPECT_TRUE(arr[0]);
@@ -428,6 +436,58 @@ TEST(BitArray_test, to_string)
     EXPECT_THROW(arr1.to_string(), std::invalid_argument);
 }
 
+TEST(BitArray_test, word_layout)
+{
+    const int dim = sizeof(unsigned long) * 8;
+    BitArray arr(2 * dim + 8);
+    arr.set(0);
+    arr.set(dim - 1);
+    arr.set(dim);
+    arr.set(2 * dim + 7);
+    EXPECT_EQ(arr.data()[0], 1UL | (1UL << (dim - 1)));
+    EXPECT_EQ(arr.data()[1], 1UL);
+    EXPECT_EQ(arr.data()[2], 1UL << 7);
+    EXPECT_TRUE(arr[dim - 1]);
+    EXPECT_FALSE(arr[dim - 2]);
+    EXPECT_EQ(arr.count(), 4);
+
+    arr <<= dim - 1;
+    EXPECT_TRUE(arr[0]);
+    EXPECT_TRUE(arr[1]);
+    EXPECT_TRUE(arr[dim + 8]);
+    EXPECT_EQ(arr.count(), 3);
+    arr >>= dim + 3;
+    EXPECT_TRUE(arr[dim + 3]);
+    EXPECT_TRUE(arr[dim + 4]);
+    EXPECT_EQ(arr.count(), 2);
+
+    BitArray arr1(10);
+    arr1.set();
+    EXPECT_EQ(arr1.data()[0], 0x3FFUL);
+    EXPECT_EQ((~BitArray(10)).data()[0], 0x3FFUL);
+}
+
+TEST(BitArray_test, legacy_order)
+{
+    const int dim = sizeof(unsigned long) * 8;
+    unsigned long legacy[2] = {1UL << (dim - 1) | 1UL, ~0UL};
+    BitArray arr = BitArray::from_legacy(legacy, dim + 4);
+    EXPECT_EQ(arr.size(), dim + 4);
+    EXPECT_TRUE(arr[0]);
+    EXPECT_TRUE(arr[dim - 1]);
+    EXPECT_FALSE(arr[1]);
+    EXPECT_EQ(arr.count(), 6);
+
+    unsigned long out[2] = {0, 0};
+    arr.to_legacy(out);
+    EXPECT_EQ(out[0], legacy[0]);
+    EXPECT_EQ(out[1], 0xFUL << (dim - 4));
+    EXPECT_EQ(BitArray::from_legacy(out, dim + 4), arr);
+
+    EXPECT_TRUE(BitArray::from_legacy(nullptr, 0).empty());
+    EXPECT_THROW(BitArray::from_legacy(legacy, -1), std::invalid_argument);
+}
+
 TEST(BitArray_test, equality_operator)
 {
     BitArray arr1(32, 0b1010);
@@ -497,4 +557,1031 @@ TEST(BitArray_test, bitwise_xor_2)
     EXPECT_EQ(arr.to_string(), BitArray(32, 0b010110).to_string());
     arr1.resize(16);
     EXPECT_THROW(arr1 ^ arr2, std::runtime_error);
-}
\ No newline at end of file
+}
+namespace
+{
+    long long traced_words = 0;
+
+    void trace(BitArrayOp op, long long words, void *context)
+    {
+        if (op == BitArrayOp::copy_construct)
+            traced_words += words;
+        ++*static_cast<int *>(context);
+    }
+}
+
+TEST(BitArray_test, stats)
+{
+    bitarray_stats_reset();
+    bitarray_stats_enable(true);
+    int traced_calls = 0;
+    bitarray_set_trace_hook(trace, &traced_calls);
+
+    BitArray arr(128, 0b1010);
+    BitArray copy(arr);
+    copy.set(0);
+    copy = arr;
+    copy.resize(256);
+    arr.push_back(true);
+
+    bitarray_set_trace_hook(nullptr);
+    bitarray_stats_enable(false);
+    BitArrayStats stats = bitarray_stats();
+
+    if (bitarray_stats_available())
+    {
+        EXPECT_TRUE(bitarray_stats_enabled() == false);
+        EXPECT_EQ(stats.calls_of(BitArrayOp::copy_construct), 1u);
+        EXPECT_EQ(stats.calls_of(BitArrayOp::assign), 1u);
+        EXPECT_EQ(stats.reallocations, 2u);
+        EXPECT_EQ(stats.allocations, 5u);
+        EXPECT_EQ(stats.deallocations, 3u);
+        EXPECT_EQ(stats.bytes_copied, 4u * 128 / 8);
+        EXPECT_EQ(traced_words, 128 / (8 * long(sizeof(unsigned long))));
+        EXPECT_GT(traced_calls, 0);
+    }
+    else
+    {
+        EXPECT_EQ(stats.allocations, 0u);
+        EXPECT_EQ(stats.calls_of(BitArrayOp::copy_construct), 0u);
+        EXPECT_EQ(traced_calls, 0);
+    }
+
+    EXPECT_STREQ(bitarray_op_name(BitArrayOp::push_back), "push_back");
+    EXPECT_STREQ(bitarray_op_name(BitArrayOp::bit_andnot), "bit_andnot");
+}
+
+namespace
+{
+    // the context of a trace hook that checks it is called with its own context
+    struct TraceCheck
+    {
+        std::atomic<int> calls{0};
+        std::atomic<int> mismatches{0};
+    };
+
+    TraceCheck check_a;
+    TraceCheck check_b;
+
+    void trace_a(BitArrayOp, long long, void *context)
+    {
+        check_a.mismatches += context != &check_a;
+        ++check_a.calls;
+    }
+
+    void trace_b(BitArrayOp, long long, void *context)
+    {
+        check_b.mismatches += context != &check_b;
+        ++check_b.calls;
+    }
+}
+
+TEST(BitArray_test, trace_hook_threads)
+{
+    bitarray_stats_enable(true);
+    std::atomic<bool> done{false};
+    std::vector<std::thread> recorders;
+
+    for (int t = 0; t < 3; ++t)
+    {
+        recorders.emplace_back([&] {
+            while (!done.load())
+                bitarray_record_op(BitArrayOp::count, 1); // called directly, so the hooks are raced without BITARRAY_STATS too
+        });
+    }
+
+    for (int k = 0; k < 2000; ++k)
+        bitarray_set_trace_hook(k % 2 == 0 ? trace_a : trace_b, k % 2 == 0 ? static_cast<void *>(&check_a) : static_cast<void *>(&check_b));
+
+    done = true;
+    for (std::thread &t : recorders)
+        t.join();
+
+    bitarray_set_trace_hook(trace_a, &check_a);
+    bitarray_record_op(BitArrayOp::count, 1);
+    bitarray_set_trace_hook(nullptr);
+    bitarray_record_op(BitArrayOp::count, 1);
+    bitarray_stats_enable(false);
+
+    EXPECT_EQ(check_a.mismatches.load(), 0); // every hook was called with the context installed with it
+    EXPECT_EQ(check_b.mismatches.load(), 0);
+    EXPECT_GT(check_a.calls.load(), 0);
+}
+
+TEST(BitArray_test, hash)
+{
+    BitArray arr1(200, 0b1010);
+    BitArray arr2(200, 0b1010);
+    EXPECT_EQ(arr1.hash(), arr2.hash());
+    EXPECT_EQ(std::hash<BitArray>()(arr1), arr1.hash());
+    arr2.set(199);
+    EXPECT_NE(arr1.hash(), arr2.hash());
+    arr2.reset(199);
+    EXPECT_EQ(arr1.hash(), arr2.hash());
+    EXPECT_NE(BitArray(10).hash(), BitArray(11).hash());
+    EXPECT_EQ(BitArray().hash(), BitArray().hash());
+
+    std::unordered_set<BitArray> set;
+    for (int i = 0; i < 100; ++i)
+        set.insert(BitArray(64, i % 10));
+    EXPECT_EQ(set.size(), 10u);
+    EXPECT_EQ(set.count(BitArray(64, 3)), 1u);
+}
+
+TEST(BitArray_test, less_operator)
+{
+    BitArray arr1(100, 0b1010);
+    BitArray arr2(100, 0b1010);
+    EXPECT_FALSE(arr1 < arr2);
+    arr2.set(99);
+    EXPECT_TRUE(arr1 < arr2);
+    EXPECT_FALSE(arr2 < arr1);
+    arr1.set(98);
+    EXPECT_TRUE(arr1 < arr2);
+    EXPECT_TRUE(BitArray(10, ~0UL) < BitArray(11));
+    EXPECT_TRUE(BitArray() < BitArray(1));
+    EXPECT_FALSE(BitArray() < BitArray());
+
+    std::set<BitArray> set;
+    set.insert(BitArray(8, 5));
+    set.insert(BitArray(8, 3));
+    set.insert(BitArray(8, 5));
+    set.insert(BitArray(4, 7));
+    EXPECT_EQ(set.size(), 3u);
+    EXPECT_EQ(set.begin()->size(), 4);
+    EXPECT_EQ(std::next(set.begin())->to_string(), BitArray(8, 3).to_string());
+}
+
+TEST(BitArray_test, extract)
+{
+    BitArray arr(200);
+    arr.set(70);
+    arr.set(140);
+    BitArray part = arr.extract(65, 100);
+    EXPECT_EQ(part.size(), 100);
+    EXPECT_TRUE(part[5]);
+    EXPECT_TRUE(part[75]);
+    EXPECT_EQ(part.count(), 2);
+    EXPECT_EQ(arr.extract(0, 3).to_string(), "000");
+    EXPECT_TRUE(arr.extract(10, 0).empty());
+    EXPECT_THROW(arr.extract(150, 51), std::out_of_range);
+    EXPECT_THROW(arr.extract(-1, 2), std::out_of_range);
+
+    BitArray arr1;
+    EXPECT_THROW(arr1.extract(0, 0), std::invalid_argument);
+}
+
+TEST(BitArray_test, insert)
+{
+    BitArray arr(100);
+    arr.set(0);
+    arr.set(99);
+    BitArray block(70);
+    block.set();
+    arr.insert(50, block);
+    EXPECT_EQ(arr.size(), 170);
+    EXPECT_EQ(arr.count(), 72);
+    EXPECT_TRUE(arr[0]);
+    EXPECT_FALSE(arr[49]);
+    EXPECT_TRUE(arr[50]);
+    EXPECT_TRUE(arr[119]);
+    EXPECT_FALSE(arr[120]);
+    EXPECT_TRUE(arr[169]);
+
+    arr.insert(170, BitArray(3, 0b101));
+    EXPECT_EQ(arr.size(), 173);
+    EXPECT_TRUE(arr[170]);
+    EXPECT_TRUE(arr[172]);
+    arr.insert(1, arr);
+    EXPECT_EQ(arr.size(), 346);
+    EXPECT_EQ(arr.count(), 2 * 74);
+    EXPECT_TRUE(arr[1]);
+    EXPECT_TRUE(arr[173]);
+    EXPECT_FALSE(arr[174]);
+    EXPECT_THROW(arr.insert(347, block), std::out_of_range);
+
+    BitArray arr1;
+    arr1.insert(0, BitArray(5, 0b10011));
+    EXPECT_EQ(arr1.to_string(), "11001");
+    arr1.insert(2, BitArray());
+    EXPECT_EQ(arr1.to_string(), "11001");
+}
+
+TEST(BitArray_test, erase)
+{
+    BitArray arr(200);
+    arr.set(10);
+    arr.set(100);
+    arr.set(199);
+    arr.erase(11, 100);
+    EXPECT_EQ(arr.size(), 111);
+    EXPECT_TRUE(arr[10]);
+    EXPECT_TRUE(arr[11]);
+    EXPECT_TRUE(arr[110]);
+    EXPECT_EQ(arr.count(), 3);
+    arr.erase(0, 11);
+    EXPECT_EQ(arr.size(), 100);
+    EXPECT_EQ(arr.count(), 2);
+    arr.resize(164);
+    EXPECT_EQ(arr.count(), 2);
+    EXPECT_THROW(arr.erase(5, 4), std::out_of_range);
+    EXPECT_THROW(arr.erase(0, 165), std::out_of_range);
+    arr.erase(0, 164);
+    EXPECT_TRUE(arr.empty());
+    EXPECT_THROW(arr.erase(0, 0), std::invalid_argument);
+}
+
+TEST(BitArray_test, replace)
+{
+    BitArray arr(150);
+    BitArray block(80);
+    block.set();
+    arr.replace(60, block);
+    EXPECT_EQ(arr.count(), 80);
+    EXPECT_FALSE(arr[59]);
+    EXPECT_TRUE(arr[60]);
+    EXPECT_TRUE(arr[139]);
+    EXPECT_FALSE(arr[140]);
+    arr.replace(0, arr.extract(70, 10));
+    EXPECT_EQ(arr.count(), 90);
+    arr.replace(0, arr);
+    EXPECT_EQ(arr.count(), 90);
+    EXPECT_THROW(arr.replace(71, block), std::out_of_range);
+
+    BitArray arr1;
+    EXPECT_THROW(arr1.replace(0, block), std::invalid_argument);
+}
+
+TEST(BitArray_test, words)
+{
+    std::uint64_t words[3] = {0x8000000000000001ULL, 0xF0ULL, ~0ULL};
+    BitArray arr = BitArray::from_words(words, 140);
+    EXPECT_EQ(arr.size(), 140);
+    EXPECT_TRUE(arr[0]);
+    EXPECT_TRUE(arr[63]);
+    EXPECT_TRUE(arr[68]);
+    EXPECT_EQ(arr.count(), 2 + 4 + 12);
+
+    std::uint64_t out[3] = {1, 1, 1};
+    arr.to_words(out);
+    EXPECT_EQ(out[0], words[0]);
+    EXPECT_EQ(out[1], words[1]);
+    EXPECT_EQ(out[2], 0xFFFULL);
+
+    EXPECT_TRUE(BitArray::from_words(nullptr, 0).empty());
+    EXPECT_THROW(BitArray::from_words(words, -1), std::invalid_argument);
+}
+
+TEST(BitArray_test, bytes)
+{
+    unsigned char bytes[3] = {0x01, 0x80, 0x0F};
+    BitArray arr = BitArray::from_bytes(bytes, 20);
+    EXPECT_TRUE(arr[0]);
+    EXPECT_TRUE(arr[15]);
+    EXPECT_TRUE(arr[16]);
+    EXPECT_TRUE(arr[19]);
+    EXPECT_EQ(arr.count(), 6);
+
+    BitArray arr1 = BitArray::from_bytes(bytes, 20, ByteOrder::little, BitOrder::msb_first);
+    EXPECT_TRUE(arr1[7]);
+    EXPECT_TRUE(arr1[8]);
+    EXPECT_FALSE(arr1[16]);
+    EXPECT_EQ(arr1.count(), 2);
+
+    BitArray arr2 = BitArray::from_bytes(bytes, 24, ByteOrder::big);
+    EXPECT_TRUE(arr2[0]);
+    EXPECT_TRUE(arr2[3]);
+    EXPECT_TRUE(arr2[15]);
+    EXPECT_TRUE(arr2[16]);
+    EXPECT_EQ(arr2.count(), 6);
+
+    unsigned char out[3] = {};
+    arr.to_bytes(out);
+    EXPECT_EQ(out[0], 0x01);
+    EXPECT_EQ(out[1], 0x80);
+    EXPECT_EQ(out[2], 0x0F);
+    arr2.to_bytes(out, ByteOrder::big, BitOrder::msb_first);
+    EXPECT_EQ(out[0], 0x80);
+    EXPECT_EQ(out[1], 0x01);
+    EXPECT_EQ(out[2], 0xF0);
+    EXPECT_EQ(BitArray::from_bytes(out, 24, ByteOrder::big, BitOrder::msb_first), arr2);
+
+    BitArray arr3(100);
+    arr3.set(3);
+    arr3.set(77);
+    unsigned char out1[13] = {};
+    arr3.to_bytes(out1, ByteOrder::big);
+    EXPECT_EQ(out1[7], 0x08);
+    EXPECT_EQ(out1[11], 0x20);
+    EXPECT_EQ(BitArray::from_bytes(out1, 100, ByteOrder::big), arr3);
+}
+
+TEST(BitArray_test, vector_and_bitset)
+{
+    std::vector<bool> v(130);
+    v[1] = true;
+    v[129] = true;
+    BitArray arr = BitArray::from_vector(v);
+    EXPECT_EQ(arr.size(), 130);
+    EXPECT_TRUE(arr[1]);
+    EXPECT_TRUE(arr[129]);
+    EXPECT_EQ(arr.count(), 2);
+    EXPECT_EQ(arr.to_vector(), v);
+    EXPECT_TRUE(BitArray::from_vector(std::vector<bool>()).empty());
+
+    std::bitset<150> b;
+    b.set(0);
+    b.set(64);
+    b.set(149);
+    BitArray arr1 = BitArray::from_bitset(b);
+    EXPECT_EQ(arr1.size(), 150);
+    EXPECT_TRUE(arr1[0]);
+    EXPECT_TRUE(arr1[64]);
+    EXPECT_TRUE(arr1[149]);
+    EXPECT_EQ(arr1.count(), 3);
+    EXPECT_EQ(arr1.to_bitset<150>(), b);
+    EXPECT_EQ(BitArray::from_bitset(std::bitset<5>(0b10110)).to_string(), "01101");
+    EXPECT_THROW(arr1.to_bitset<149>(), std::runtime_error);
+}
+
+TEST(BitArray_test, adopt)
+{
+    std::unique_ptr<std::uint64_t[]> buffer(new std::uint64_t[2]{0x5ULL, ~0ULL});
+    const std::uint64_t *raw = buffer.get();
+    BitArray arr(10, 0b1);
+    arr.adopt(std::move(buffer), 70);
+    EXPECT_EQ(buffer, nullptr);
+    EXPECT_EQ(arr.size(), 70);
+    EXPECT_EQ(arr.count(), 2 + 6);
+    if (sizeof(unsigned long) == sizeof(std::uint64_t))
+    {
+        EXPECT_EQ(static_cast<const void *>(arr.data()), static_cast<const void *>(raw));
+    }
+
+    arr.push_back(true);
+    EXPECT_EQ(arr.count(), 9);
+    BitArray copy(arr);
+    copy.adopt(std::unique_ptr<std::uint64_t[]>(new std::uint64_t[1]{0x3ULL}), 2);
+    EXPECT_EQ(copy.to_string(), "11");
+    copy.swap(arr);
+    EXPECT_EQ(arr.to_string(), "11");
+    arr.adopt(nullptr, 0);
+    EXPECT_TRUE(arr.empty());
+    EXPECT_THROW(arr.adopt(nullptr, 5), std::invalid_argument);
+
+    bitarray_stats_reset();
+    bitarray_stats_enable(true);
+    {
+        BitArray adopted;
+        adopted.adopt(std::unique_ptr<std::uint64_t[]>(new std::uint64_t[2]{}), 100);
+    }
+    bitarray_stats_enable(false);
+    BitArrayStats stats = bitarray_stats();
+    EXPECT_EQ(stats.allocations, stats.deallocations); // the adopted buffer is recorded as allocated and freed once
+    if (bitarray_stats_available() && sizeof(unsigned long) == sizeof(std::uint64_t))
+    {
+        EXPECT_EQ(stats.allocations, 1u);
+        EXPECT_EQ(stats.bytes_allocated, 2u * 8);
+    }
+}
+
+TEST(BitArray_test, rotate)
+{
+    BitArray arr(8, 0b00010011);
+    arr.rotate_left(1);
+    EXPECT_EQ(arr.to_string(), "10010001");
+    arr.rotate_right(3);
+    EXPECT_EQ(arr.to_string(), "00110010");
+    arr.rotate_left(16);
+    EXPECT_EQ(arr.to_string(), "00110010");
+    EXPECT_THROW(arr.rotate_left(-1), std::invalid_argument);
+
+    for (int length : {1, 63, 64, 65, 1000, 3001})
+    {
+        BitArray arr1(length);
+        for (int i = 0; i < length; i += 3)
+            arr1.set(i);
+        arr1.set(length - 1);
+        for (int k : {0, 1, 7, 64, 65, length / 2, length - 1, length + 5})
+        {
+            BitArray expected(length);
+            for (int i = 0; i < length; ++i)
+                expected.set(i, arr1[(i + k) % length]);
+            BitArray left(arr1);
+            left.rotate_left(k);
+            EXPECT_EQ(left, expected);
+            EXPECT_EQ(arr1.rotl(k), expected);
+            left.rotate_right(k);
+            EXPECT_EQ(left, arr1);
+            EXPECT_EQ(expected.rotr(k), arr1);
+        }
+    }
+
+    BitArray arr2;
+    EXPECT_THROW(arr2.rotate_left(1), std::invalid_argument);
+    EXPECT_THROW(arr2.rotr(1), std::invalid_argument);
+}
+
+TEST(BitArray_test, batch_operations)
+{
+    BitArray arr(300);
+    int sorted[] = {0, 1, 1, 63, 64, 65, 200, 299};
+    arr.set_many(sorted, 8);
+    EXPECT_EQ(arr.count(), 7);
+    EXPECT_TRUE(arr[63]);
+    EXPECT_TRUE(arr[299]);
+
+    int unsorted[] = {299, 5, 64, 150, 0};
+    arr.reset_many(unsorted, 5);
+    EXPECT_EQ(arr.count(), 4);
+    EXPECT_FALSE(arr[0]);
+    EXPECT_FALSE(arr[299]);
+
+    arr.flip_many(unsorted, 5);
+    EXPECT_EQ(arr.count(), 9);
+    arr.flip_many(sorted, 8);
+    EXPECT_TRUE(arr[1]);
+    EXPECT_FALSE(arr[63]);
+    EXPECT_TRUE(arr[5]);
+    int repeated[] = {7, 3, 7};
+    arr.flip_many(repeated, 3);
+    EXPECT_FALSE(arr[7]);
+    EXPECT_TRUE(arr[3]);
+
+    bool out[5];
+    arr.test_many(unsorted, 5, out);
+    EXPECT_FALSE(out[0]);
+    EXPECT_TRUE(out[1]);
+    EXPECT_FALSE(out[2]);
+    EXPECT_TRUE(out[3]);
+    EXPECT_FALSE(out[4]);
+
+    std::vector<int> many;
+    for (int i = 0; i < 1000; ++i)
+        many.push_back((i * 7919) % 300);
+    BitArray arr1(300);
+    arr1.set_many(many.data(), static_cast<int>(many.size()));
+    EXPECT_EQ(arr1.count(), 300);
+
+    int bad[] = {1, 2, 300};
+    BitArray before(arr);
+    EXPECT_THROW(arr.set_many(bad, 3), std::out_of_range);
+    EXPECT_EQ(arr, before);
+    EXPECT_THROW(arr.test_many(bad, 3, out), std::out_of_range);
+    EXPECT_THROW(arr.set_many(bad, -1), std::invalid_argument);
+    EXPECT_NO_THROW(arr.set_many(nullptr, 0));
+
+    BitArray arr2;
+    EXPECT_THROW(arr2.set_many(sorted, 1), std::invalid_argument);
+}
+
+TEST(BitArray_test, arithmetic)
+{
+    BitArray ones(130);
+    ones.set();
+    BitArray one(130, 1UL);
+
+    BitArray arr(ones);
+    EXPECT_TRUE(arr.add(one));
+    EXPECT_TRUE(arr.none());
+    EXPECT_TRUE(arr.sub(one));
+    EXPECT_EQ(arr, ones);
+    EXPECT_FALSE(arr.sub(one));
+    EXPECT_EQ(arr.count(), 129);
+    EXPECT_FALSE(arr[0]);
+
+    const std::uint64_t low_ones[] = {~0ULL, 0ULL, 0ULL};
+    BitArray arr1 = BitArray::from_words(low_ones, 130);
+    EXPECT_FALSE(arr1.increment());
+    EXPECT_EQ(arr1.count(), 1);
+    EXPECT_TRUE(arr1[64]);
+    BitArray arr2(ones);
+    EXPECT_TRUE(arr2.increment());
+    EXPECT_TRUE(arr2.none());
+    BitArray arr3(70);
+    arr3.set();
+    arr3.reset(69);
+    EXPECT_FALSE(arr3.increment());
+    EXPECT_EQ(arr3.count(), 1);
+    arr3.set();
+    EXPECT_TRUE(arr3.increment());
+    EXPECT_TRUE(arr3.none());
+
+    BitArray arr4 = BitArray::from_words(low_ones, 130);
+    EXPECT_EQ(arr4.multiply(3), 0UL);
+    std::uint64_t words[3];
+    arr4.to_words(words);
+    EXPECT_EQ(words[0], ~0ULL - 2);
+    EXPECT_EQ(words[1], 2ULL);
+    BitArray arr5(70);
+    arr5.set(69).set(0);
+    EXPECT_EQ(arr5.multiply(6), 3UL);
+    EXPECT_EQ(arr5.count(), 2);
+    EXPECT_TRUE(arr5[1]);
+    EXPECT_TRUE(arr5[2]);
+
+    BitArray arr6(ones);
+    arr6.reset(0);
+    BitArray negated(arr6);
+    negated.negate();
+    EXPECT_EQ(negated.count(), 1);
+    EXPECT_TRUE(negated[1]);
+    EXPECT_TRUE(negated.add(arr6));
+    EXPECT_TRUE(negated.none());
+
+    std::uint64_t x = 0x123456789ULL;
+    for (int i = 0; i < 100; ++i)
+    {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        std::uint64_t y = x >> 17;
+        const std::uint64_t mask = (1ULL << 37) - 1;
+        BitArray a(37, static_cast<unsigned long>(x));
+        BitArray b(37, static_cast<unsigned long>(y));
+        EXPECT_EQ(a.compare(b), (x & mask) < (y & mask) ? -1 : ((x & mask) > (y & mask) ? 1 : 0));
+        BitArray sum(a);
+        EXPECT_EQ(sum.add(b), (x & mask) + (y & mask) > mask);
+        EXPECT_EQ(sum, BitArray(37, static_cast<unsigned long>((x + y) & mask)));
+        BitArray difference(a);
+        EXPECT_EQ(difference.sub(b), (x & mask) < (y & mask));
+        EXPECT_EQ(difference, BitArray(37, static_cast<unsigned long>((x - y) & mask)));
+        BitArray product(a);
+        EXPECT_EQ(product.multiply(1000), static_cast<unsigned long>(((x & mask) * 1000) >> 37));
+        EXPECT_EQ(product, BitArray(37, static_cast<unsigned long>((x * 1000) & mask)));
+    }
+
+    EXPECT_EQ(ones.compare(one), 1);
+    EXPECT_EQ(one.compare(ones), -1);
+    EXPECT_EQ(one.compare(BitArray(130, 1UL)), 0);
+    EXPECT_EQ(BitArray().compare(BitArray()), 0);
+    EXPECT_THROW(one.add(BitArray(129)), std::runtime_error);
+    EXPECT_THROW(BitArray().increment(), std::invalid_argument);
+}
+
+TEST(BitArray_test, change_tracking)
+{
+    BitArray arr(5000);
+    EXPECT_FALSE(arr.tracking_changes());
+    EXPECT_THROW(arr.delta(), std::invalid_argument);
+    EXPECT_THROW(arr.mark_changed(0, 1), std::invalid_argument);
+
+    arr.set(10).set(4000);
+    BitArray replica(arr);
+    arr.track_changes();
+    EXPECT_TRUE(arr.tracking_changes());
+    EXPECT_TRUE(arr.delta().ranges.empty());
+
+    arr.set(3).reset(10).set(1000);
+    int indices[] = {4999, 1001};
+    arr.flip_many(indices, 2);
+    BitArrayDelta delta = arr.delta();
+    EXPECT_EQ(delta.num_bits, 5000);
+    EXPECT_EQ(delta.ranges, std::vector<int>({0, 16, 72, 79}));
+    EXPECT_EQ(delta.words.size(), 16 + 7);
+
+    replica.apply_delta(delta);
+    EXPECT_EQ(replica, arr);
+
+    arr.clear_changes();
+    EXPECT_TRUE(arr.delta().ranges.empty());
+    arr.data()[20] = ~0UL;
+    arr.mark_changed(20 * BitArray::change_block_bits / 8, 20 * BitArray::change_block_bits / 8 + 1);
+    arr.push_back(true);
+    arr.erase(0, 3);
+    replica.apply_delta(arr.delta());
+    EXPECT_EQ(replica, arr);
+    EXPECT_THROW(arr.mark_changed(0, 6000), std::out_of_range);
+
+    arr.clear_changes();
+    arr.resize(100);
+    replica.apply_delta(arr.delta());
+    EXPECT_EQ(replica.size(), 100);
+    EXPECT_EQ(replica, arr);
+
+    BitArray other(100);
+    other.set();
+    arr.clear_changes();
+    arr.swap(other);
+    replica.apply_delta(arr.delta());
+    EXPECT_EQ(replica.count(), 100);
+    EXPECT_FALSE(other.tracking_changes());
+
+    arr.clear();
+    replica.apply_delta(arr.delta());
+    EXPECT_TRUE(replica.empty());
+
+    BitArrayDelta bad;
+    bad.num_bits = 64;
+    bad.ranges = {0, 2};
+    bad.words = {1, 2};
+    EXPECT_THROW(replica.apply_delta(bad), std::invalid_argument);
+    bad.ranges = {0, 1};
+    EXPECT_THROW(replica.apply_delta(bad), std::invalid_argument);
+    bad.words = {5};
+    replica.apply_delta(bad);
+    EXPECT_EQ(replica.count(), 2);
+
+    arr.track_changes(false);
+    EXPECT_THROW(arr.delta(), std::invalid_argument);
+}
+
+TEST(BitArray_test, to_indices)
+{
+    BitArray empty;
+    std::uint32_t none[1];
+    EXPECT_THROW(empty.to_indices(none), std::invalid_argument);
+
+    BitArray arr(5000);
+    std::vector<std::uint64_t> expected;
+    unsigned long long state = 42;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        bool bit = i < 1000 ? (state >> 60) != 0 : i < 3000 ? (state >> 61) == 0 : (state >> 63) != 0; // dense, sparse and random regions
+        if (bit || i == 4999)
+        {
+            arr.set(i);
+            expected.push_back(i);
+        }
+    }
+
+    std::vector<std::uint32_t> narrow(arr.count());
+    std::vector<std::uint64_t> wide(arr.count());
+    EXPECT_EQ(arr.to_indices(narrow.data()), arr.count());
+    EXPECT_EQ(arr.to_indices(wide.data()), arr.count());
+    EXPECT_EQ(wide, expected);
+    EXPECT_EQ(std::vector<std::uint64_t>(narrow.begin(), narrow.end()), expected);
+
+    BitArray full(130);
+    full.set();
+    std::vector<std::uint32_t> appended = {7, 8};
+    full.append_indices(appended);
+    ASSERT_EQ(appended.size(), 132);
+    EXPECT_EQ(appended[1], 8);
+    for (int i = 0; i < 130; ++i)
+        EXPECT_EQ(appended[i + 2], i);
+
+    std::vector<std::uint64_t> zeros;
+    BitArray(70).append_indices(zeros);
+    EXPECT_TRUE(zeros.empty());
+}
+
+TEST(BitArray_test, placement)
+{
+    BitArray small(1000, Placement::huge_pages);
+    EXPECT_EQ(small.memory_placement(), Placement::huge_pages);
+    EXPECT_EQ(small.count(), 0);
+
+    const int num_bits = 3 * BitArray::huge_page_bytes * 8 + 100;
+    BitArray arr(num_bits, Placement::interleaved);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arr.data()) % BitArray::alignment, 0);
+    EXPECT_EQ(arr.count(), 0);
+    arr.set(0).set(num_bits - 1).set(12345678);
+
+    BitArray copy(arr);
+    EXPECT_EQ(copy.memory_placement(), Placement::interleaved);
+    EXPECT_EQ(copy, arr);
+
+    arr.push_back(true);
+    arr.resize(num_bits + 5000, true);
+    EXPECT_EQ(arr.count(), 3 + 1 + 5000 - 1);
+    EXPECT_EQ(arr.memory_placement(), Placement::interleaved);
+
+    BitArray heap(10);
+    heap.swap(arr);
+    EXPECT_EQ(heap.memory_placement(), Placement::interleaved);
+    EXPECT_EQ(arr.memory_placement(), Placement::heap);
+    EXPECT_TRUE(heap[12345678]);
+
+    small.clear();
+    small = heap;
+    EXPECT_EQ(small.memory_placement(), Placement::huge_pages);
+    EXPECT_EQ(small, heap);
+    small.resize(64);
+    EXPECT_EQ(small.count(), 1);
+    small.clear();
+    EXPECT_TRUE(small.empty());
+
+    EXPECT_THROW(BitArray(-1, Placement::huge_pages), std::invalid_argument);
+}
+
+TEST(BitArray_test, random_fill)
+{
+    BitArray empty;
+    Xoshiro256 rng(1);
+    EXPECT_THROW(empty.fill_random(rng), std::invalid_argument);
+    EXPECT_THROW(empty.random_set_bit(rng), std::invalid_argument);
+
+    BitArray arr(100003);
+    arr.fill_random(rng);
+    EXPECT_NEAR(arr.count(), 50000, 1000);
+    const int dim = sizeof(unsigned long) * 8;
+    EXPECT_EQ(arr.data()[100003 / dim] >> (100003 % dim), 0UL);
+
+    Xoshiro256 same(1);
+    BitArray replay(100003);
+    replay.fill_random(same);
+    EXPECT_EQ(replay, arr);
+
+    std::mt19937 narrow(7);
+    replay.fill_random(narrow);
+    EXPECT_NEAR(replay.count(), 50000, 1000);
+    EXPECT_NE(replay, arr);
+
+    arr.fill_bernoulli(0.1, rng);
+    EXPECT_NEAR(arr.count(), 10000, 500);
+    arr.fill_bernoulli(0.75, rng);
+    EXPECT_NEAR(arr.count(), 75000, 800);
+    arr.fill_bernoulli(1.0, rng);
+    EXPECT_EQ(arr.count(), 100003);
+    arr.fill_bernoulli(0.0, rng);
+    EXPECT_EQ(arr.count(), 0);
+    EXPECT_THROW(arr.fill_bernoulli(1.5, rng), std::invalid_argument);
+    EXPECT_THROW(arr.fill_bernoulli(std::nan(""), rng), std::invalid_argument);
+    EXPECT_THROW(arr.random_set_bit(rng), std::invalid_argument);
+
+    arr.set(5).set(700).set(100002);
+    EXPECT_EQ(arr.select(0), 5);
+    EXPECT_EQ(arr.select(1), 700);
+    EXPECT_EQ(arr.select(2), 100002);
+    EXPECT_THROW(arr.select(3), std::out_of_range);
+
+    std::set<int> seen;
+    for (int i = 0; i < 200; ++i)
+        seen.insert(arr.random_set_bit(rng));
+    EXPECT_EQ(seen, std::set<int>({5, 700, 100002}));
+}
+
+TEST(BitArray_test, fused_shifts)
+{
+    Xoshiro256 rng(3);
+    BitArray a(1000), b(1000);
+    EXPECT_THROW(a.or_shifted(BitArray(999), 1), std::runtime_error);
+    EXPECT_THROW(a.or_shifted(BitArray(), 1), std::invalid_argument);
+    EXPECT_THROW(BitArray().and_shifted(a, 1), std::invalid_argument);
+
+    int shifts[] = {0, 1, 63, 64, 65, 130, 999, 1000, 5000, -1, -63, -64, -200, -999, -1000, -5000};
+
+    for (int k : shifts)
+    {
+        a.fill_random(rng);
+        b.fill_random(rng);
+        BitArray shifted = k >= 0 ? (k >= 1000 ? BitArray(1000) : b << k) : (k <= -1000 ? BitArray(1000) : b >> -k);
+
+        EXPECT_EQ(BitArray(a).or_shifted(b, k), a | shifted) << k;
+        EXPECT_EQ(BitArray(a).and_shifted(b, k), a & shifted) << k;
+        EXPECT_EQ(BitArray(a).xor_shifted(b, k), a ^ shifted) << k;
+        EXPECT_EQ(BitArray(a).andnot_shifted(b, k), a & ~shifted) << k;
+
+        BitArray self(a);
+        BitArray self_shifted = k >= 0 ? (k >= 1000 ? BitArray(1000) : a << k) : (k <= -1000 ? BitArray(1000) : a >> -k);
+        EXPECT_EQ(self.or_shifted(self, k), a | self_shifted) << k;
+        self = a;
+        EXPECT_EQ(self.xor_shifted(self, k), a ^ self_shifted) << k;
+        self = a;
+        EXPECT_EQ(self.andnot_shifted(self, k), a & ~self_shifted) << k;
+    }
+
+    BitArray sums(20);
+    sums.set(0);
+    int weights[] = {3, 5, 7};
+    for (int w : weights)
+        sums.or_shifted(sums, -w); // the subset sums of the weights
+    EXPECT_EQ(sums.to_string(), "10010101101010010000");
+}
+
+TEST(BitArray_test, move)
+{
+    BitArray arr(100, 5);
+    const unsigned long *words = arr.data();
+
+    BitArray moved(std::move(arr));
+    EXPECT_TRUE(arr.empty());
+    EXPECT_EQ(arr.size(), 0);
+    EXPECT_EQ(moved.data(), words); // the memory is taken, not copied
+    EXPECT_EQ(moved.count(), 2);
+
+    BitArray other(7);
+    other.track_changes();
+    other = std::move(moved); // the arrays of different sizes are moved without the sizes check of the copy
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(other.data(), words);
+    EXPECT_EQ(other.size(), 100);
+    EXPECT_EQ(other.delta().num_bits, 100);
+
+    arr.push_back(true); // a moved-from array is usable
+    EXPECT_EQ(arr.to_string(), "1");
+
+    BitArray mapped(BitArray::huge_page_bytes * 8, Placement::huge_pages);
+    BitArray taken(std::move(mapped));
+    EXPECT_EQ(taken.memory_placement(), Placement::huge_pages);
+    taken.set(12345);
+    EXPECT_EQ(taken.count(), 1);
+
+    std::vector<BitArray> arrays;
+    for (int k = 0; k < 100; ++k)
+        arrays.push_back(BitArray(65, k)); // the vector moves the arrays when it grows
+    EXPECT_EQ(arrays[99].count(), 4);
+}
+
+TEST(BitArray_test, extras)
+{
+    EXPECT_EQ(sizeof(BitArray), 2 * sizeof(void *) + 2 * sizeof(int)); // the words, the length, the capacity and the pointer to the opt-in state
+
+    BitArray tracked(100);
+    tracked.track_changes();
+    tracked.cache_count();
+    tracked.set(3);
+
+    BitArray copy(tracked);
+    EXPECT_FALSE(copy.tracking_changes()); // the copy takes the bits only
+    EXPECT_FALSE(copy.caching_count());
+
+    BitArray moved(std::move(tracked));
+    EXPECT_TRUE(moved.tracking_changes()); // the move constructor takes the features with the memory
+    EXPECT_TRUE(moved.caching_count());
+    EXPECT_EQ(moved.count(), 1);
+    EXPECT_EQ(moved.delta().ranges.size(), 2u);
+    EXPECT_FALSE(tracked.tracking_changes());
+    tracked.push_back(true);
+    EXPECT_EQ(tracked.count(), 1);
+
+    BitArray mapped(BitArray::huge_page_bytes * 8, Placement::huge_pages);
+    BitArray plain(10);
+    plain.swap(mapped);
+    EXPECT_EQ(plain.memory_placement(), Placement::huge_pages);
+    EXPECT_EQ(mapped.memory_placement(), Placement::heap);
+    plain.set(77);
+    mapped.push_back(true);
+    EXPECT_EQ(mapped.count(), 1);
+
+    plain = std::move(mapped); // the mapped memory is freed and the heap memory of mapped is taken
+    EXPECT_EQ(plain.memory_placement(), Placement::heap);
+    EXPECT_EQ(plain.size(), 11);
+    plain.resize(200, true);
+    EXPECT_EQ(plain.count(), 190);
+
+    std::unique_ptr<std::uint64_t[]> buffer(new std::uint64_t[1]{0xFULL});
+    BitArray adopted;
+    adopted.adopt(std::move(buffer), 64);
+    BitArray target(5);
+    target = std::move(adopted); // the adopted buffer is freed by its new owner as it was allocated
+    EXPECT_EQ(target.count(), 4);
+    adopted.push_back(false);
+    EXPECT_EQ(adopted.count(), 0);
+}
+
+TEST(BitArray_test, any_none_all)
+{
+    const int sizes[] = {1, 63, 64, 65, 511, 512, 513, 1024, 2048 + 17, 5000};
+
+    EXPECT_THROW(BitArray().all(), std::invalid_argument);
+
+    for (int num_bits : sizes)
+    {
+        BitArray arr(num_bits);
+        EXPECT_FALSE(arr.any());
+        EXPECT_TRUE(arr.none());
+        EXPECT_FALSE(arr.all());
+
+        for (int pos : {0, num_bits / 2, num_bits - 1}) // a single true bit in the first chunk, a middle one and the tail
+        {
+            arr.reset().set(pos);
+            EXPECT_TRUE(arr.any()) << num_bits << " " << pos;
+            EXPECT_EQ(arr.all(), num_bits == 1);
+
+            arr.set().reset(pos);
+            EXPECT_FALSE(arr.all()) << num_bits << " " << pos;
+            EXPECT_EQ(arr.none(), num_bits == 1);
+        }
+
+        arr.set();
+        EXPECT_TRUE(arr.all());
+        EXPECT_TRUE(arr.any());
+    }
+}
+
+TEST(BitArray_test, cached_count)
+{
+    BitArray arr(1000);
+    EXPECT_FALSE(arr.caching_count());
+    arr.cache_count();
+    EXPECT_TRUE(arr.caching_count());
+
+    EXPECT_EQ(arr.count(), 0);
+    arr.set(5).set(5).set(999).reset(6);
+    EXPECT_EQ(arr.count(), 2);
+    arr.reset(5);
+    EXPECT_EQ(arr.count(), 1);
+    EXPECT_TRUE(arr.any());
+    EXPECT_FALSE(arr.all());
+
+    arr.push_back(true);
+    arr.push_back(false);
+    EXPECT_EQ(arr.size(), 1002);
+    EXPECT_EQ(arr.count(), 2);
+
+    arr <<= 1; // the bulk changes make the next count recount
+    EXPECT_EQ(arr.count(), 2);
+    arr.set();
+    EXPECT_EQ(arr.count(), 1002);
+    EXPECT_TRUE(arr.all());
+    arr.resize(10);
+    EXPECT_EQ(arr.count(), 10);
+    arr.data()[0] = 1UL; // the count is recounted after data()
+    EXPECT_EQ(arr.count(), 1);
+
+    BitArray other(10);
+    arr.swap(other);
+    EXPECT_EQ(arr.count(), 0);
+    EXPECT_TRUE(arr.caching_count()); // the mode stays with the object
+
+    arr.clear();
+    arr.push_back(true);
+    EXPECT_EQ(arr.count(), 1);
+
+    arr.track_changes();
+    arr.push_back(true);
+    arr.set(0, false);
+    EXPECT_EQ(arr.count(), 1); // the tracked set keeps the count
+    EXPECT_EQ(arr.to_string(), "01");
+
+    arr.cache_count(false);
+    arr.set(0);
+    EXPECT_EQ(arr.count(), 2);
+}
+
+TEST(BitArray_test, cached_count_batch)
+{
+    BitArray arr(1000);
+    arr.cache_count();
+    EXPECT_FALSE(arr.tracking_changes());
+    EXPECT_EQ(arr.count(), 0);
+
+    const int indices[] = {3, 64, 500, 999};
+    arr.set_many(indices, 4);
+    EXPECT_EQ(arr.count(), 4); // the batches make the next count recount without the tracking
+    EXPECT_TRUE(arr.any());
+    arr.reset_many(indices, 2);
+    EXPECT_EQ(arr.count(), 2);
+    arr.flip_many(indices, 4);
+    EXPECT_EQ(arr.count(), 2);
+    EXPECT_EQ(arr[3], true);
+    EXPECT_EQ(arr[999], false);
+}
+
+TEST(BitArray_test, cached_count_copy)
+{
+    BitArray arr(10);
+    arr.cache_count();
+    arr.set(1).set(2).set(3);
+    EXPECT_EQ(arr.count(), 3);
+
+    const BitArray empty;
+    arr = empty; // the copy of a named empty array
+    EXPECT_TRUE(arr.empty());
+    arr.push_back(true);
+    EXPECT_EQ(arr.count(), 1);
+    std::vector<std::uint32_t> indices;
+    arr.append_indices(indices);
+    EXPECT_EQ(indices, std::vector<std::uint32_t>{0});
+
+    BitArray other(1, 0b0);
+    arr = other;
+    EXPECT_EQ(arr.count(), 0);
+    arr.set(0);
+    EXPECT_EQ(arr.count(), 1);
+}
+
+TEST(BitArray_test, cached_count_move)
+{
+    BitArray arr(100);
+    arr.cache_count();
+    arr.set(1).set(2).set(3);
+    EXPECT_EQ(arr.count(), 3);
+
+    BitArray moved(std::move(arr));
+    EXPECT_EQ(moved.count(), 3);
+    arr.push_back(true); // the moved-from object is an empty array again
+    EXPECT_EQ(arr.count(), 1);
+    EXPECT_TRUE(arr.any());
+
+    BitArray target(10);
+    target.cache_count();
+    EXPECT_EQ(target.count(), 0);
+    target = std::move(moved);
+    EXPECT_EQ(target.count(), 3);
+    moved.cache_count();
+    moved = std::move(target);
+    target.resize(5, true);
+    EXPECT_EQ(target.count(), 5);
+    EXPECT_TRUE(target.all());
+
+    BitArray empty;
+    moved.swap(empty); // the counted array is swapped out for an empty one
+    EXPECT_EQ(empty.count(), 3);
+    moved.push_back(false);
+    EXPECT_EQ(moved.count(), 0);
+    EXPECT_FALSE(moved.any());
+    EXPECT_TRUE(moved.none());
+}
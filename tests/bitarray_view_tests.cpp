@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "../lib/bitarray_view.hpp"
+
+TEST(BitArrayView_test, constructors)
+{
+    BitArrayView view;
+    EXPECT_TRUE(view.empty());
+    EXPECT_THROW(view.count(), std::invalid_argument);
+
+    BitArray arr(200);
+    arr.set(70);
+    BitArrayView view1(arr);
+    EXPECT_EQ(view1.size(), 200);
+    EXPECT_TRUE(view1[70]);
+    BitArrayView view2(arr, 65, 10);
+    EXPECT_EQ(view2.size(), 10);
+    EXPECT_TRUE(view2[5]);
+    EXPECT_THROW(BitArrayView(arr, 195, 10), std::out_of_range);
+    EXPECT_THROW(BitArrayView(arr, -1, 10), std::out_of_range);
+    EXPECT_THROW(view2[10], std::out_of_range);
+
+    unsigned long words[2] = {0b1000UL, 1UL};
+    BitArrayView view3(words, 3, 2 * BitArrayView::dim - 3);
+    EXPECT_TRUE(view3[0]);
+    EXPECT_TRUE(view3[BitArrayView::dim - 3]);
+    EXPECT_EQ(view3.count(), 2);
+    EXPECT_THROW(BitArrayView(nullptr, 0, 5), std::invalid_argument);
+}
+
+TEST(BitArrayView_test, read_operations)
+{
+    BitArray arr(300);
+    arr.set(100);
+    arr.set(170);
+    arr.set(171);
+    BitArrayView view(arr, 99, 150);
+    EXPECT_TRUE(view.any());
+    EXPECT_FALSE(view.none());
+    EXPECT_FALSE(view.all());
+    EXPECT_EQ(view.count(), 3);
+    EXPECT_EQ(view.find_first(), 1);
+    EXPECT_EQ(view.find_next(1), 71);
+    EXPECT_EQ(view.find_next(71), 72);
+    EXPECT_EQ(view.find_next(72), -1);
+    EXPECT_EQ(view.subview(2, 60).find_first(), -1);
+    EXPECT_TRUE(view.subview(2, 60).none());
+    EXPECT_EQ(view.subview(0, 3).to_string(), "010");
+
+    BitArray copy = view.subview(70, 4).to_bitarray();
+    EXPECT_EQ(copy.to_string(), "0110");
+
+    arr.set();
+    EXPECT_TRUE(BitArrayView(arr, 3, 250).all());
+    EXPECT_EQ(BitArrayView(arr, 3, 250).count(), 250);
+}
+
+TEST(BitArrayView_test, equality_operator)
+{
+    BitArray arr1(200);
+    BitArray arr2(200);
+    arr1.set(10);
+    arr2.set(80);
+    EXPECT_TRUE(BitArrayView(arr1, 5, 100) == BitArrayView(arr2, 75, 100));
+    EXPECT_FALSE(BitArrayView(arr1, 5, 100) != BitArrayView(arr2, 75, 100));
+    EXPECT_TRUE(BitArrayView(arr1, 6, 100) != BitArrayView(arr2, 75, 100));
+    EXPECT_THROW(BitArrayView(arr1, 6, 10) == BitArrayView(arr2, 75, 100), std::runtime_error);
+}
+
+TEST(BitArraySpan_test, in_place_operations)
+{
+    BitArray arr(256);
+    BitArray mask(256);
+    mask.set();
+    BitArraySpan span(arr, 30, 100);
+    span |= BitArrayView(mask, 7, 100);
+    EXPECT_EQ(arr.count(), 100);
+    EXPECT_FALSE(arr[29]);
+    EXPECT_TRUE(arr[30]);
+    EXPECT_TRUE(arr[129]);
+    EXPECT_FALSE(arr[130]);
+
+    mask.reset(50);
+    span &= BitArrayView(mask, 20, 100);
+    EXPECT_EQ(arr.count(), 99);
+    EXPECT_FALSE(arr[60]);
+
+    span ^= BitArrayView(mask, 0, 100);
+    EXPECT_EQ(arr.count(), 2);
+    EXPECT_TRUE(arr[60]);
+    EXPECT_TRUE(arr[80]);
+
+    span.flip();
+    EXPECT_EQ(arr.count(), 98);
+    span.reset();
+    EXPECT_TRUE(arr.none());
+    span.set();
+    EXPECT_TRUE(span.all());
+    EXPECT_EQ(arr.count(), 100);
+    span.reset(0);
+    EXPECT_FALSE(arr[30]);
+    EXPECT_THROW(span.set(100), std::out_of_range);
+    EXPECT_THROW(span &= BitArrayView(mask, 0, 10), std::runtime_error);
+    EXPECT_THROW(BitArraySpan().set(), std::invalid_argument);
+}
+
+TEST(BitArraySpan_test, assign)
+{
+    BitArray arr(200);
+    arr.set(0);
+    arr.set(65);
+    BitArraySpan(arr, 3, 100).assign(BitArrayView(arr, 0, 100));
+    EXPECT_TRUE(arr[3]);
+    EXPECT_TRUE(arr[68]);
+    EXPECT_TRUE(arr[0]);
+    EXPECT_FALSE(arr[65]);
+    EXPECT_EQ(arr.count(), 3);
+
+    unsigned long words[3] = {};
+    BitArraySpan span(words, 10, 150);
+    span.assign(BitArrayView(arr, 0, 150));
+    EXPECT_EQ(span.to_string(), BitArrayView(arr, 0, 150).to_string());
+    EXPECT_TRUE(span.view() == BitArrayView(arr, 0, 150));
+    EXPECT_EQ(span.subspan(60, 20).find_first(), 8);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "../lib/bitmatrix.hpp"
+
+#include <climits>
+#include <random>
+
+namespace
+{
+    BitMatrix random_matrix(int rows, int cols, std::mt19937 &rng)
+    {
+        BitMatrix m(rows, cols);
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < cols; ++c)
+                m.set(r, c, (rng() & 1) != 0);
+        return m;
+    }
+
+    BitMatrix naive_multiply(const BitMatrix &a, const BitMatrix &b, bool boolean)
+    {
+        BitMatrix c(a.rows(), b.cols());
+        for (int i = 0; i < a.rows(); ++i)
+            for (int j = 0; j < b.cols(); ++j)
+            {
+                bool sum = false;
+                for (int k = 0; k < a.cols(); ++k)
+                {
+                    bool product = a.get(i, k) && b.get(k, j);
+                    sum = boolean ? (sum || product) : (sum != product);
+                }
+                c.set(i, j, sum);
+            }
+        return c;
+    }
+}
+
+TEST(BitMatrix_test, constructors_and_access)
+{
+    BitMatrix empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.rows(), 0);
+    EXPECT_THROW(BitMatrix(-1, 2), std::invalid_argument);
+    EXPECT_THROW(BitMatrix(100000, 100000), std::invalid_argument); // the size is computed without an int overflow
+    EXPECT_THROW(BitMatrix(2, INT_MAX), std::invalid_argument);
+    EXPECT_TRUE(BitMatrix(0, INT_MAX).empty());
+
+    BitMatrix m(3, 70);
+    EXPECT_EQ(m.rows(), 3);
+    EXPECT_EQ(m.cols(), 70);
+    m.set(1, 69).set(2, 0);
+    EXPECT_TRUE(m.get(1, 69));
+    EXPECT_TRUE(m.get(2, 0));
+    EXPECT_FALSE(m.get(0, 0));
+    m.reset(1, 69);
+    EXPECT_FALSE(m.get(1, 69));
+    EXPECT_THROW(m.get(3, 0), std::out_of_range);
+    EXPECT_THROW(m.set(0, 70), std::out_of_range);
+
+    BitMatrix id = BitMatrix::identity(3);
+    EXPECT_EQ(id.to_string(), "100\n010\n001");
+}
+
+TEST(BitMatrix_test, rows_as_views)
+{
+    BitMatrix m(4, 100);
+    m.row(2).set(5).set(99);
+    EXPECT_TRUE(m.get(2, 5));
+    EXPECT_TRUE(m.get(2, 99));
+    EXPECT_EQ(m.row(2).count(), 2);
+
+    const BitMatrix &cm = m;
+    BitArrayView row = cm.row(2);
+    EXPECT_EQ(row.size(), 100);
+    EXPECT_EQ(row.find_first(), 5);
+    EXPECT_EQ(row.to_bitarray().count(), 2);
+
+    m.row(0).assign(cm.row(2));
+    m.swap_rows(0, 3);
+    EXPECT_TRUE(m.row(0).none());
+    EXPECT_TRUE(cm.row(3) == cm.row(2));
+    EXPECT_THROW(m.row(4), std::out_of_range);
+}
+
+TEST(BitMatrix_test, transpose)
+{
+    std::mt19937 rng(1);
+    const int sizes[][2] = {{1, 1}, {3, 70}, {64, 64}, {130, 65}, {200, 129}};
+
+    for (const auto &size : sizes)
+    {
+        BitMatrix m = random_matrix(size[0], size[1], rng);
+        BitMatrix t = m.transpose();
+        ASSERT_EQ(t.rows(), size[1]);
+        ASSERT_EQ(t.cols(), size[0]);
+        for (int r = 0; r < m.rows(); ++r)
+            for (int c = 0; c < m.cols(); ++c)
+                ASSERT_EQ(m.get(r, c), t.get(c, r));
+        EXPECT_TRUE(t.transpose() == m);
+    }
+}
+
+TEST(BitMatrix_test, multiply)
+{
+    std::mt19937 rng(2);
+    BitMatrix a = random_matrix(37, 75, rng);
+    BitMatrix b = random_matrix(75, 130, rng);
+
+    EXPECT_TRUE(a.multiply(b) == naive_multiply(a, b, false));
+    EXPECT_TRUE(a.boolean_multiply(b) == naive_multiply(a, b, true));
+    EXPECT_TRUE(a.multiply(BitMatrix::identity(75)) == a);
+    EXPECT_THROW(a.multiply(a), std::runtime_error);
+
+    BitMatrix sum = a;
+    sum ^= a;
+    EXPECT_EQ(sum.rank(), 0);
+    EXPECT_THROW(sum ^= b, std::runtime_error);
+}
+
+TEST(BitMatrix_test, elimination_and_rank)
+{
+    EXPECT_EQ(BitMatrix::identity(100).rank(), 100);
+
+    BitMatrix m(3, 4);
+    m.set(0, 0).set(0, 1);
+    m.set(1, 1).set(1, 2);
+    m.set(2, 0).set(2, 2); // the row 2 is the sum of rows 0 and 1
+    EXPECT_EQ(m.rank(), 2);
+    EXPECT_EQ(m.eliminate(), 2);
+    EXPECT_EQ(m.to_string(), "1010\n0110\n0000");
+
+    std::mt19937 rng(3);
+    BitMatrix a = random_matrix(90, 40, rng);
+    BitMatrix b = random_matrix(40, 90, rng);
+    BitMatrix product = a.multiply(b);
+    EXPECT_LE(product.rank(), 40);
+    EXPECT_EQ(product.rank(), product.transpose().rank());
+
+    BitMatrix reduced = product;
+    int rank = reduced.eliminate();
+    EXPECT_EQ(rank, product.rank());
+    for (int r = 0; r < rank; ++r)
+    {
+        int pivot = reduced.row(r).find_first();
+        ASSERT_GE(pivot, 0);
+        for (int i = 0; i < reduced.rows(); ++i)
+            EXPECT_EQ(reduced.get(i, pivot), i == r);
+    }
+    for (int r = rank; r < reduced.rows(); ++r)
+        EXPECT_TRUE(reduced.row(r).none());
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "../lib/bitsliced_index.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    std::vector<std::uint64_t> column(int num_rows, std::uint64_t max, std::uint64_t seed)
+    {
+        std::vector<std::uint64_t> values(num_rows);
+        for (int i = 0; i < num_rows; ++i)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            values[i] = (seed >> 20) % (max + 1);
+        }
+        return values;
+    }
+
+    template <typename Predicate>
+    BitArray naive(const std::vector<std::uint64_t> &values, Predicate predicate)
+    {
+        BitArray rows(static_cast<int>(values.size()));
+        for (std::size_t i = 0; i < values.size(); ++i)
+            rows.set(static_cast<int>(i), predicate(values[i]));
+        return rows;
+    }
+}
+
+TEST(BitSlicedIndex_test, construction)
+{
+    BitSlicedIndex empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.num_slices(), 0);
+    EXPECT_THROW(BitSlicedIndex(nullptr, 3), std::invalid_argument);
+    EXPECT_THROW(BitSlicedIndex(nullptr, -1), std::invalid_argument);
+
+    std::vector<std::uint64_t> values = column(1000, 5000, 1);
+    values[7] = 5000;
+    BitSlicedIndex index(values.data(), 1000);
+    EXPECT_EQ(index.size(), 1000);
+    EXPECT_EQ(index.num_slices(), 13);
+    for (int i = 0; i < 1000; ++i)
+        ASSERT_EQ(index.value(i), values[i]);
+    EXPECT_EQ(index.slice(12).count(), static_cast<int>(std::count_if(values.begin(), values.end(), [](std::uint64_t v) { return (v >> 12) & 1; })));
+    EXPECT_THROW(index.slice(13), std::out_of_range);
+    EXPECT_THROW(index.value(1000), std::out_of_range);
+
+    std::vector<std::uint64_t> zeros(10, 0);
+    BitSlicedIndex flat(zeros.data(), 10);
+    EXPECT_EQ(flat.num_slices(), 0);
+    EXPECT_EQ(flat.equal(0).count(), 10);
+    EXPECT_EQ(flat.less(1).count(), 10);
+    EXPECT_TRUE(flat.greater(0).none());
+}
+
+TEST(BitSlicedIndex_test, predicates)
+{
+    std::vector<std::uint64_t> values = column(3001, 9000, 2);
+    BitSlicedIndex index(values.data(), 3001);
+
+    const std::uint64_t probes[] = {0, 1, 100, 4095, 4096, 5000, 8999, 9000, 1ULL << 20, ~0ULL};
+    for (std::uint64_t c : probes)
+    {
+        EXPECT_EQ(index.equal(c), naive(values, [c](std::uint64_t v) { return v == c; }));
+        EXPECT_EQ(index.less(c), naive(values, [c](std::uint64_t v) { return v < c; }));
+        EXPECT_EQ(index.less_equal(c), naive(values, [c](std::uint64_t v) { return v <= c; }));
+        EXPECT_EQ(index.greater(c), naive(values, [c](std::uint64_t v) { return v > c; }));
+        EXPECT_EQ(index.greater_equal(c), naive(values, [c](std::uint64_t v) { return v >= c; }));
+    }
+
+    EXPECT_EQ(index.between(100, 5000), naive(values, [](std::uint64_t v) { return v >= 100 && v <= 5000; }));
+    EXPECT_TRUE(index.between(5000, 100).none());
+
+    std::vector<std::uint64_t> wide = {~0ULL, 0, 1ULL << 63, 12345};
+    BitSlicedIndex wide_index(wide.data(), 4);
+    EXPECT_EQ(wide_index.num_slices(), 64);
+    EXPECT_EQ(wide_index.greater(1ULL << 62).to_string(), "1010");
+    EXPECT_EQ(wide_index.equal(~0ULL).to_string(), "1000");
+}
+
+TEST(BitSlicedIndex_test, top_k_and_sum)
+{
+    std::vector<std::uint64_t> values = column(2000, 300, 3);
+    BitSlicedIndex index(values.data(), 2000);
+
+    std::vector<std::uint64_t> sorted(values);
+    std::sort(sorted.begin(), sorted.end(), std::greater<std::uint64_t>());
+    const int ks[] = {0, 1, 10, 77, 1999, 2000, 5000};
+    for (int k : ks)
+    {
+        BitArray top = index.top_k(k);
+        int expected = std::min(k, 2000);
+        ASSERT_EQ(top.count(), expected);
+        if (expected == 0)
+            continue;
+        std::uint64_t boundary = sorted[expected - 1];
+        EXPECT_TRUE((index.greater(boundary) & ~top).none());
+        EXPECT_TRUE((top & index.less(boundary)).none());
+    }
+    EXPECT_THROW(index.top_k(-1), std::invalid_argument);
+
+    std::uint64_t total = 0, selected = 0;
+    BitArray rows = index.between(50, 150);
+    for (int i = 0; i < 2000; ++i)
+    {
+        total += values[i];
+        if (rows[i])
+            selected += values[i];
+    }
+    EXPECT_EQ(index.sum(), total);
+    EXPECT_EQ(index.sum(rows), selected);
+    EXPECT_THROW(index.sum(BitArray(10)), std::runtime_error);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "../lib/bloomfilter.hpp"
+
+#include <climits>
+
+TEST(BloomFilter_test, constructors)
+{
+    BloomFilter filter;
+    EXPECT_TRUE(filter.empty());
+    EXPECT_THROW(filter.insert(1), std::invalid_argument);
+    EXPECT_THROW(filter.contains(1), std::invalid_argument);
+
+    BloomFilter filter1(1000);
+    EXPECT_EQ(filter1.size(), 1024);
+    EXPECT_FALSE(filter1.empty());
+    EXPECT_THROW(BloomFilter(0), std::invalid_argument);
+    EXPECT_THROW(BloomFilter(INT_MAX), std::invalid_argument);
+    EXPECT_THROW(BloomFilter(INT_MAX - BloomFilter::block_bits + 2), std::invalid_argument);
+    EXPECT_THROW(BloomFilter(BitArray(100)), std::invalid_argument);
+    EXPECT_THROW(BloomFilter{BitArray()}, std::invalid_argument);
+}
+
+TEST(BloomFilter_test, insert_contains)
+{
+    BloomFilter filter(10000 * 10);
+    for (std::uint64_t key = 0; key < 10000; ++key)
+        filter.insert(key * 3);
+    for (std::uint64_t key = 0; key < 10000; ++key)
+        EXPECT_TRUE(filter.contains(key * 3));
+    EXPECT_LE(filter.storage().count(), 10000 * BloomFilter::num_hashes);
+
+    int false_positives = 0;
+    for (std::uint64_t key = 0; key < 10000; ++key)
+        false_positives += filter.contains(key * 3 + 1) ? 1 : 0;
+    EXPECT_LT(false_positives, 300);
+
+    filter.clear();
+    EXPECT_TRUE(filter.storage().none());
+    EXPECT_FALSE(filter.contains(3));
+}
+
+TEST(BloomFilter_test, batch_operations)
+{
+    std::vector<std::uint64_t> keys;
+    for (std::uint64_t key = 0; key < 500; ++key)
+        keys.push_back(key * 0x9E3779B97F4A7C15ULL);
+    BloomFilter filter(500 * 12);
+    filter.insert_many(keys.data(), static_cast<int>(keys.size()));
+
+    std::unique_ptr<bool[]> out(new bool[keys.size()]);
+    filter.contains_many(keys.data(), static_cast<int>(keys.size()), out.get());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        EXPECT_TRUE(out[i]);
+
+    BloomFilter filter1(500 * 12);
+    for (std::uint64_t key : keys)
+        filter1.insert(key);
+    EXPECT_EQ(filter1.storage(), filter.storage());
+    EXPECT_THROW(filter.insert_many(keys.data(), -1), std::invalid_argument);
+}
+
+TEST(BloomFilter_test, union_intersection)
+{
+    BloomFilter a(4096);
+    BloomFilter b(4096);
+    a.insert(1);
+    a.insert(2);
+    b.insert(2);
+    b.insert(3);
+
+    BloomFilter u(a);
+    u |= b;
+    EXPECT_TRUE(u.contains(1));
+    EXPECT_TRUE(u.contains(2));
+    EXPECT_TRUE(u.contains(3));
+
+    BloomFilter i(a);
+    i &= b;
+    EXPECT_TRUE(i.contains(2));
+    EXPECT_LE(i.storage().count(), a.storage().count());
+
+    BloomFilter c(8192);
+    EXPECT_THROW(a |= c, std::runtime_error);
+}
+
+TEST(BloomFilter_test, serialisation)
+{
+    BloomFilter filter(2048);
+    filter.insert(42);
+    filter.insert(7);
+
+    std::vector<std::uint64_t> words((filter.size() + 63) / 64);
+    filter.storage().to_words(words.data());
+
+    BloomFilter restored(BitArray::from_words(words.data(), filter.size()));
+    EXPECT_TRUE(restored.contains(42));
+    EXPECT_TRUE(restored.contains(7));
+    EXPECT_EQ(restored.storage(), filter.storage());
+}
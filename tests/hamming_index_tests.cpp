@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "../lib/hamming_index.hpp"
+#include "../lib/bitarray_random.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    // the k nearest codes found by (a ^ b).count() over all codes
+    std::vector<std::pair<int, int>> brute_force(const std::vector<BitArray> &codes, const BitArray &query, int k)
+    {
+        std::vector<std::pair<int, int>> all;
+        for (int id = 0; id < static_cast<int>(codes.size()); ++id)
+            all.push_back({(codes[id] ^ query).count(), id});
+        std::sort(all.begin(), all.end());
+        all.resize(std::min<std::size_t>(k, all.size()));
+        return all;
+    }
+
+    std::vector<std::pair<int, int>> as_pairs(const std::vector<HammingMatch> &matches)
+    {
+        std::vector<std::pair<int, int>> pairs;
+        for (const HammingMatch &m : matches)
+            pairs.push_back({m.distance, m.id});
+        return pairs;
+    }
+
+    // codes clustered around a few centres, each with a few flipped bits, so the neighbours are close
+    std::vector<BitArray> clustered(int num, int num_bits, Xoshiro256 &rng)
+    {
+        std::vector<BitArray> centres(8, BitArray(num_bits));
+        for (BitArray &c : centres)
+            c.fill_random(rng);
+        std::vector<BitArray> codes;
+        for (int i = 0; i < num; ++i)
+        {
+            BitArray code(centres[rng() % centres.size()]);
+            BitArray noise(num_bits);
+            noise.fill_bernoulli(0.02, rng);
+            codes.push_back(code ^ noise);
+        }
+        return codes;
+    }
+}
+
+TEST(HammingIndex_test, arguments)
+{
+    EXPECT_THROW(HammingIndex(256, -1), std::invalid_argument);
+    EXPECT_THROW(HammingIndex(256, 3), std::invalid_argument);
+    EXPECT_THROW(HammingIndex(4, 5), std::invalid_argument);
+
+    HammingIndex index(256);
+    EXPECT_TRUE(index.search(BitArray(256), 5).empty());
+    EXPECT_THROW(index.add(BitArray(255)), std::runtime_error);
+    EXPECT_THROW(index.search(BitArray(255), 1), std::runtime_error);
+    EXPECT_THROW(index.search(BitArray(256), -1), std::invalid_argument);
+}
+
+TEST(HammingIndex_test, scan)
+{
+    Xoshiro256 rng(5);
+    const int sizes[] = {256, 300, 1024};
+
+    for (int num_bits : sizes)
+    {
+        HammingIndex index(num_bits);
+        std::vector<BitArray> codes;
+        for (int i = 0; i < 2000; ++i)
+        {
+            BitArray code(num_bits);
+            code.fill_random(rng);
+            if (i % 100 == 7)
+                code = codes[i - 1]; // the duplicate codes make ties
+            codes.push_back(code);
+            EXPECT_EQ(index.add(code), i);
+        }
+        EXPECT_EQ(index.size(), 2000);
+        EXPECT_EQ(index.bits(), num_bits);
+
+        for (int q = 0; q < 5; ++q)
+        {
+            BitArray query(codes[q * 301]);
+            query.set(q);
+            EXPECT_EQ(as_pairs(index.search(query, 10)), brute_force(codes, query, 10)) << num_bits;
+        }
+        EXPECT_EQ(index.search(codes[0], 5000).size(), 2000);
+    }
+}
+
+TEST(HammingIndex_test, multi_index_hashing)
+{
+    Xoshiro256 rng(6);
+    const int num_bits = 256;
+    std::vector<BitArray> codes = clustered(3000, num_bits, rng);
+    HammingIndex index(num_bits, 8);
+    HammingIndex random_index(num_bits, 4);
+    for (const BitArray &code : codes)
+    {
+        index.add(code);
+        random_index.add(code);
+    }
+
+    std::vector<BitArray> queries;
+    for (int q = 0; q < 20; ++q)
+    {
+        BitArray query(codes[q * 97]);
+        query.flip_many(std::vector<int>({q, q + 50, q + 100}).data(), 3);
+        queries.push_back(query);
+        EXPECT_EQ(as_pairs(index.search(query, 5)), brute_force(codes, query, 5)) << q;
+        EXPECT_EQ(as_pairs(random_index.search(query, 50)), brute_force(codes, query, 50)) << q;
+    }
+
+    BitArray far(num_bits);
+    far.fill_random(rng);
+    EXPECT_EQ(as_pairs(index.search(far, 3)), brute_force(codes, far, 3));
+
+    std::vector<std::vector<HammingMatch>> batch = index.search(queries, 5, 4);
+    ASSERT_EQ(batch.size(), queries.size());
+    for (std::size_t q = 0; q < queries.size(); ++q)
+        EXPECT_EQ(as_pairs(batch[q]), brute_force(codes, queries[q], 5));
+
+    EXPECT_TRUE(index.search(std::vector<BitArray>(), 5).empty());
+    EXPECT_THROW(index.search(std::vector<BitArray>(1, BitArray(3)), 5), std::runtime_error);
+}